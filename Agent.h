@@ -0,0 +1,26 @@
+#ifndef AGENT_H
+#define AGENT_H
+
+#include <utility>
+
+// Base class of the agents that move through a Maze: the agent's position as (row, col).
+class Agent {
+protected:
+    std::pair<int, int> position; // Current position as (row, col)
+
+public:
+    Agent(int row, int col) : position(row, col) {}
+    virtual ~Agent() {}
+
+    // Function to move the agent to (row, col)
+    void setPosition(int row, int col) {
+        position = std::make_pair(row, col);
+    }
+
+    // Function to get the agent's position as (row, col)
+    std::pair<int, int> getPosition() const {
+        return position;
+    }
+};
+
+#endif // AGENT_H
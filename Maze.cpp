@@ -1,6 +1,8 @@
 
 #include "Maze.h"
 #include "Agent.h"
+#include "Version_2/MazeBinary.h"
+#include "Trace.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -8,8 +10,14 @@
 #include <algorithm>
 
 void Maze::loadMaze(const std::string& filename) {
+    if (isMazeBinaryFile(filename)) {
+        loadMazeBinary(filename);
+        return;
+    }
+
     std::ifstream file(filename);
-    grid.clear();
+    resize(0, 0);
+    std::vector<std::vector<int> > grid; // Rows as parsed from the file
 
     if (!file.is_open()) {
         std::cerr << "Failed to open file: " << filename << std::endl;
@@ -19,7 +27,7 @@ void Maze::loadMaze(const std::string& filename) {
     std::string line;
     while (std::getline(file, line)) {
         // Print the original line
-        std::cout << "Original line: " << line << std::endl;
+        TRACE_DEBUG("Original line: " << line);
 
         // Remove unwanted characters
         line.erase(std::remove_if(line.begin(), line.end(), [](char c) {
@@ -27,7 +35,7 @@ void Maze::loadMaze(const std::string& filename) {
         }), line.end());
 
         // Print the processed line
-        std::cout << "Processed line: " << line << std::endl;
+        TRACE_DEBUG("Processed line: " << line);
 
         std::vector<int> row;
         std::stringstream ss(line);
@@ -38,21 +46,103 @@ void Maze::loadMaze(const std::string& filename) {
         grid.push_back(row);
     }
 
+    // Reject codes with no cell type, as the Version_2 loader does, leaving the maze empty
+    for (std::size_t row = 0; row < grid.size(); ++row) {
+        for (std::size_t col = 0; col < grid[row].size(); ++col) {
+            if (grid[row][col] < 0 || grid[row][col] >= MAZE_ELEMENT_COUNT) {
+                std::cerr << "Error: Unknown cell code " << grid[row][col] << " at (" << row << ", " << col << ") of " << filename << "." << std::endl;
+                return;
+            }
+        }
+    }
+
+    // Copy the parsed rows into the padded grid
+    resize(grid.size(), grid.empty() ? 0 : grid[0].size());
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols && col < static_cast<int>(grid[row].size()); ++col) {
+            cells[index(row, col)] = static_cast<std::uint8_t>(grid[row][col]);
+        }
+    }
+    buildMoves();
+
     // Print the grid to verify its contents
-    std::cout << "Loaded maze grid:" << std::endl;
-    for (const auto& row : grid) {
-        for (int cell : row) {
-            std::cout << cell << " ";
+    if (TRACE_ENABLED(TRACE_LEVEL_DEBUG)) {
+        printMaze();
+    }
+    TRACE_INFO("Loaded " << rows << "x" << cols << " maze from " << filename);
+}
+
+bool Maze::loadMazeBinary(const std::string& filename) {
+    resize(0, 0);
+
+    MappedMazeFile file;
+    if (!file.open(filename) || !checkMazeFileCells(file, filename)) {
+        return false;
+    }
+
+    const MazeFileHeader& header = file.header();
+    resize(header.rows, header.cols);
+    for (std::uint32_t i = 0; i < header.rows; ++i) {
+        const std::uint8_t* row = file.cells() + static_cast<std::size_t>(i) * header.cols;
+        std::copy(row, row + header.cols, &cells[index(i, 0)]);
+    }
+    buildMoves();
+    TRACE_INFO("Loaded " << rows << "x" << cols << " maze from " << filename);
+    return true;
+}
+
+void Maze::resize(int newRows, int newCols) {
+    rows = newRows;
+    cols = newCols;
+    stride = cols + 2 * PADDING;
+    cells.assign(static_cast<std::size_t>(rows + 2 * PADDING) * stride, 1);
+    moves.assign(cells.size(), 0);
+    actionMasks.assign(cells.size(), 0);
+    for (int row = 0; row < rows; ++row) {
+        std::fill(&cells[index(row, 0)], &cells[index(row, 0)] + cols, 0);
+    }
+}
+
+void Maze::buildMoves() {
+    // Row and column change of each action, as in QLearningAgent::calculateNewPosition
+    static const int ROW_STEP[4] = {0, -1, 0, 1};
+    static const int COL_STEP[4] = {1, 0, -1, 0};
+    for (int action = 0; action < 4; ++action) {
+        for (int stepSize = 0; stepSize <= MAX_STEP_SIZE; ++stepSize) {
+            moveOffsets[action][stepSize] = stepSize * (static_cast<std::ptrdiff_t>(ROW_STEP[action]) * stride + COL_STEP[action]);
+        }
+    }
+
+    // The border is one cell wide, so longer moves are bounds-checked here, once.
+    moves.assign(cells.size(), 0);
+    actionMasks.assign(cells.size(), 0);
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            std::uint16_t open = 0;
+            std::uint8_t mask = 0;
+            for (int action = 0; action < 4; ++action) {
+                for (int stepSize = 1; stepSize <= MAX_STEP_SIZE; ++stepSize) {
+                    int newRow = row + stepSize * ROW_STEP[action];
+                    int newCol = col + stepSize * COL_STEP[action];
+                    if (newRow >= 0 && newRow < rows && newCol >= 0 && newCol < cols && isPassable(atUnchecked(newRow, newCol))) {
+                        open |= 1u << (action * MAX_STEP_SIZE + stepSize - 1);
+                        if (stepSize == 1) {
+                            mask |= 1u << action;
+                        }
+                    }
+                }
+            }
+            moves[index(row, col)] = static_cast<std::uint16_t>(open);
+            actionMasks[index(row, col)] = mask;
         }
-        std::cout << std::endl;
     }
 }
 
 void Maze::printMaze() {
     std::cout << "Maze grid:" << std::endl;
-    for (const auto& row : grid) {
-        for (int cell : row) {
-            std::cout << cell << " ";
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            std::cout << atUnchecked(row, col) << " ";
         }
         std::cout << std::endl;
     }
@@ -61,20 +151,17 @@ void Maze::printMaze() {
 
 int Maze::at(int row, int col) const {
     
-    if (row >= 0 && row < grid.size() && col >= 0 && col < grid[0].size()) {
-        return grid[row][col];
+    if (row >= 0 && row < rows && col >= 0 && col < cols) {
+        return atUnchecked(row, col);
     }
     return -1; // Return -1 for invalid positions
 }
 
 std::pair<int, int> Maze::getSize() const {
-    if (grid.empty()) {
+    if (rows == 0) {
         std::cerr << "Error: The maze grid is empty." << std::endl;
         return {0, 0};
     }
-    
-    int rows = grid.size();
-    int cols = grid.empty() ? 0 : grid[0].size(); // Check if grid is empty before accessing
 
     // Debugging: Print the size
     // std::cout << "Maze Size: Rows = " << rows << ", Cols = " << cols << std::endl;
@@ -83,12 +170,28 @@ std::pair<int, int> Maze::getSize() const {
 }
 
 std::pair<int, int> Maze::findNumberCoordinates(int number) const {
-    for (int row = 0; row < grid.size(); ++row) {
-        for (int col = 0; col < grid[row].size(); ++col) {
-            if (grid[row][col] == number) {
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            if (atUnchecked(row, col) == number) {
                 return std::make_pair(row, col);  // Return the coordinates if number is found
             }
         }
     }
     return std::make_pair(-1, -1);  // Return (-1, -1) if the number is not found
 }
+
+std::uint64_t Maze::hash() const {
+    // FNV-1a over the dimensions and cells, the same value MazeGrid::hash() gives for the maze.
+    std::uint64_t value = 14695981039346656037ULL;
+    auto mix = [&value](std::uint64_t byte) { value = (value ^ byte) * 1099511628211ULL; };
+    for (int shift = 0; shift < 32; shift += 8) {
+        mix((static_cast<std::uint32_t>(rows) >> shift) & 0xFF);
+        mix((static_cast<std::uint32_t>(cols) >> shift) & 0xFF);
+    }
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            mix(static_cast<std::uint64_t>(atUnchecked(row, col)));
+        }
+    }
+    return value;
+}
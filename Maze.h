@@ -3,30 +3,76 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
+#include "Version_2/MazeElements.h"
 
 class Maze {
 protected:
     std::pair<int, int> position;  // Agent's position in the maze
 
+public:
+    static const int PADDING = 1; // Width of the wall border around the maze
+
 private:
-    std::vector<std::vector<int> > grid; // 2D vector to store the maze
+    int rows; // Number of rows in the maze
+    int cols; // Number of columns in the maze
+    int stride; // Distance between vertically adjacent cells in the buffer
+    std::vector<std::uint8_t> cells; // Maze cells surrounded by a wall border, row-major
+    std::vector<std::uint16_t> moves; // Open moves of each cell, see landing()
+    std::vector<std::uint8_t> actionMasks; // Actions of each cell that move one step, see actionMask()
+    std::ptrdiff_t moveOffsets[4][MAX_STEP_SIZE + 1]; // Buffer offset of a move by action and stepSize
+
+    // Resize the maze, filling the inside with empty cells and the border with walls
+    void resize(int newRows, int newCols);
+    // Build the transition table from the cells, once they are loaded
+    void buildMoves();
 
 public:
     // Constructor that loads a maze from a file
-    Maze(const std::string& filename) {
+    Maze(const std::string& filename) : rows(0), cols(0), stride(0), moveOffsets() {
         loadMaze(filename);
     }
     std::pair<int, int> findNumberCoordinates(int number) const;
     // Load maze from a file
     void loadMaze(const std::string& filename);
+    // Load maze from a memory-mapped binary maze file
+    bool loadMazeBinary(const std::string& filename);
     void printMaze();
     // Get the value at a specific position in the maze
     int at(int row, int col) const;
 
+    // Buffer index of the cell at (row, col). Valid for the wall border too.
+    std::size_t index(int row, int col) const {
+        return static_cast<std::size_t>(row + PADDING) * stride + (col + PADDING);
+    }
+    // Value of the cell at a buffer index, without bounds checking
+    int cellAt(std::size_t cellIndex) const { return cells[cellIndex]; }
+    // Value at (row, col) without bounds checking. Positions one step outside the maze read as walls.
+    int atUnchecked(int row, int col) const { return cells[index(row, col)]; }
+    // Buffer offset between vertically adjacent cells
+    int rowStride() const { return stride; }
+
+    // Transition table, built at load time: bit (action * MAX_STEP_SIZE + stepSize - 1) is set
+    // when moving stepSize cells for the action (0 right, 1 up, 2 left, 3 down) stays inside
+    // the maze and lands on a passable cell.
+    unsigned openMoves(std::size_t cellIndex) const { return moves[cellIndex]; }
+    // Valid actions of a cell: bit action is set when a one-step move for it is open.
+    // Built with the transition table, so action selection needs one load per step.
+    unsigned actionMask(std::size_t cellIndex) const { return actionMasks[cellIndex]; }
+    // Buffer index reached by moving stepSize cells for the action, or cellIndex itself if
+    // the move is blocked. One table load and no branch.
+    std::size_t landing(std::size_t cellIndex, int action, int stepSize) const {
+        std::ptrdiff_t open = -static_cast<std::ptrdiff_t>((moves[cellIndex] >> (action * MAX_STEP_SIZE + stepSize - 1)) & 1);
+        return cellIndex + (moveOffsets[action][stepSize] & open);
+    }
+
     // Get the size of the maze
     std::pair<int, int> getSize() const;
+    // Hash of the dimensions and cells, identifying the maze in checkpoint files
+    std::uint64_t hash() const;
 
 
 
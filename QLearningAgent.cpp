@@ -1,119 +1,116 @@
 #include "QLearningAgent.h"
 #include <utility> // For std::pair
-#include <cstdlib> // For std::rand, std::srand
-#include <ctime> // For std::time
 #include <algorithm> // For std::max_element
+#include <cmath> // For std::fabs
+#include <cstring> // For std::memcpy
+#include <iostream>
 #include "Agent.h"
+#include "Trace.h"
+#include "Version_2/QCheckpoint.h"
 
-// Assuming these are constant for the maze
-const int GOAL_ROW = 12; // 21st row in 0-based indexing
-const int GOAL_COL = 6; // 21st column in 0-based indexing
 
-
-QLearningAgent::QLearningAgent(int row, int col) : Agent(row, col) {
-    std::srand(static_cast<unsigned int>(std::time(nullptr))); // Seed for randomness
-    // Initialize Q-table to 0
-    for (int i = 0; i < 10; i++) {
-        for (int j = 0; j < 10; j++) {
-            for (int k = 0; k < 4; k++) {
-                Q[i][j][k] = 0;
-            }
-        }
-    }
+QLearningAgent::QLearningAgent(const Maze &maze, int row, int col, std::uint64_t seed) : Agent(row, col), rng(seed) {
+    // Size the Q-table from the maze and initialize it to 0
+    std::pair<int, int> mazeSize = maze.getSize();
+    mazeRows = mazeSize.first;
+    mazeCols = mazeSize.second;
+    Q.assign(static_cast<std::size_t>(mazeRows) * mazeCols * ACTIONS, QValue(0));
     stepsTaken = 0;
     startingPosition = std::make_pair(row, col);
+    goalPosition = maze.findNumberCoordinates(GOAL);
+    policy.start = EPSILON;
+    exploration = EPSILON;
+    episodes = 0;
 }
 
 int QLearningAgent::chooseAction(const Maze &maze) {
-    if (!validMoves.empty()) {
-        int chosenIndex = std::rand() % validMoves.size();
-        int chosenAction = validMoves[chosenIndex].second;  // Extract the action
-        return chosenAction;
-    } else {
+    unsigned mask = maze.actionMask(maze.index(position.first, position.second));
+    if (mask == 0) {
         // Move backwards or choose a default action
         return (lastAction + 2) % 4;  // Example of moving backward
     }
+
+    // The policy only considers the valid actions of the cell, so blocked moves are never taken
+    std::size_t row = qIndex(position.first, position.second);
+    return policy.choose(&Q[row], ACTIONS, mask, exploration, visits.empty() ? nullptr : &visits[row], rng);
 }
 
+void QLearningAgent::enablePlanning(const Maze &maze, int updatesPerStep, std::size_t queueCapacity) {
+    planner.resize(mazeRows, mazeCols, ACTIONS, 1, updatesPerStep, queueCapacity);
+    if (planner.enabled()) {
+        // Replayed updates take their targets over the valid actions only, like real ones
+        std::vector<std::uint8_t> masks(static_cast<std::size_t>(mazeRows) * mazeCols);
+        for (int row = 0; row < mazeRows; ++row) {
+            for (int col = 0; col < mazeCols; ++col) {
+                masks[qIndex(row, col) / ACTIONS] = static_cast<std::uint8_t>(maze.actionMask(maze.index(row, col)));
+            }
+        }
+        planner.setActionMasks(masks);
+    }
+}
 
+void QLearningAgent::setExplorationPolicy(const ExplorationPolicy &newPolicy) {
+    policy = newPolicy;
+    exploration = policy.parameter(episodes);
+    if (policy.strategy == UCB) {
+        visits.assign(Q.size(), 0);
+    } else {
+        visits.clear();
+    }
+}
 
 
 
 
 
 
-void QLearningAgent::updateQValues(int action, int reward, int newRow, int newCol) {
-    // Find the maximum Q-value for the new state
-    double maxQNew = *max_element(Q[newRow][newCol], Q[newRow][newCol] + 4);
+
+
+void QLearningAgent::updateQValues(int action, int reward, int newRow, int newCol, unsigned validActions) {
+    // Find the maximum Q-value for the new state, over the actions that can be taken from it
+    const QValue* qNew = &Q[qIndex(newRow, newCol)];
+    int bestNew = ExplorationPolicy::bestAction(qNew, ACTIONS, validActions);
+    double maxQNew = bestNew < 0 ? 0.0 : static_cast<double>(qNew[bestNew]);
 
     // Update Q-value using the Q-learning formula
-    Q[position.first][position.second][action] += ALPHA * (reward + GAMMA * maxQNew - Q[position.first][position.second][action]);
+    QValue& q = Q[qIndex(position.first, position.second) + action];
+    q = static_cast<QValue>(q + ALPHA * (reward + GAMMA * maxQNew - q));
 }
 
 int QLearningAgent::calculateReward(const Maze &maze, int row, int col) {
-    int cellValue = maze.at(row, col);
-
-    switch (cellValue) {
-        case 0: // Empty space
-            return STEP_REWARD;
-        case 1: // Wall
-            return WALL_PENALTY;
-        case 2: // Goggles
-            return GOGGLES_REWARD;
-        case 3: // Speed potion
-            return SPEED_POTION_REWARD;
-        case 4: // Fog
-            return FOG_PENALTY;
-        case 5: // Slowpoke potion
-            return SLOWPOKE_POTION_PENALTY;
-        case 6: // Goal
-            return GOAL_REWARD;
-        default:
-            return 0; // Default case, if needed
-    }
+    // One table load instead of a switch over the cell codes.
+    return cellReward(maze.atUnchecked(row, col));
 }
 
 void QLearningAgent::move(const Maze &maze) {
     int action = chooseAction(maze); // Choose action based on Q-values and epsilon-greedy strategy
-    std::pair<int, int> newPosition = getNextPosition(maze, position, action, lastAction);  // Pass maze and lastAction
-    // ... rest of the method ...
-    // Calculate new position based on action
-    
-    int calcRow = position.first;
-    int calcCol = position.second;
-    // std::cout << "Attempting calc to: (" << calcRow << ", " << calcCol << ")" << std::endl;
-    // Check for boundaries and walls
-    if (isValidMove(maze, newPosition)) {
+    lastAction = action;
+
+    // The maze's transition table gives the landing cell, or the current one if the move is blocked
+    std::size_t cell = maze.index(position.first, position.second);
+    std::pair<int, int> newPosition = maze.landing(cell, action, 1) != cell ? calculateNewPosition(position, action) : position;
+
+    // Learn for the cell the action was taken in, so update before moving
+    int reward = calculateReward(maze, newPosition.first, newPosition.second);
+    std::size_t newCell = maze.index(newPosition.first, newPosition.second);
+    updateQValues(action, reward, newPosition.first, newPosition.second, maze.actionMask(newCell));
+    if (planner.enabled()) {
+        planner.update(Q.data(), qIndex(position.first, position.second) / ACTIONS, action,
+                       qIndex(newPosition.first, newPosition.second) / ACTIONS, reward, ALPHA, GAMMA);
+    }
+
+    if (newPosition != position) {
         // Update position if valid move
         position = newPosition;
         setPosition(newPosition.first, newPosition.second);
     }
 
-    int reward = calculateReward(maze, position.first, position.second);
-    updateQValues(action, reward, position.first, position.second);
-
     // Check for max steps
     if (++stepsTaken >= MAX_STEPS) {
         reset(); // Reset agent position and step count
     }
 }
 
-std::vector<std::pair<std::pair<int, int>, int>> QLearningAgent::getNextPosition(const Maze &maze, std::pair<int, int> currentPosition) {
-    std::vector<int> possibleActions = {0, 1, 2, 3}; // All possible actions: Up, Right, Down, Left
-    validMoves.clear(); // Clear previous valid moves
-
-    std::cout << "Evaluating possible moves from (" << currentPosition.first << ", " << currentPosition.second << "):" << std::endl;
-    for (int action : possibleActions) {
-        std::pair<int, int> newPosition = calculateNewPosition(currentPosition, action);
-        if (isValidMove(maze, newPosition)) {
-            validMoves.push_back(std::make_pair(newPosition, action));
-            std::cout << "Valid move: (" << newPosition.first << ", " << newPosition.second << ") with action " << action << std::endl;
-        }
-    }
-
-    return validMoves; // Correctly placed return statement
-}
-
 
 
 
@@ -144,26 +141,23 @@ int QLearningAgent::mapPositionToAction(std::pair<int, int> currentPosition, std
 
 bool QLearningAgent::isValidMove(const Maze &maze, std::pair<int, int> newPosition) {
     // Get the size of the maze and check if the new position is within bounds and not a wall
-    std::pair<int, int> mazeSize = maze.getSize();
-    int mazeRows = 21;
-    int mazeCols = 21;
     int newRow = newPosition.first;
     int newCol = newPosition.second;
 
     // Debugging: Print current and new position
-    std::cout << "Current Position: (" << position.first << ", " << position.second << ")" << std::endl;
-    std::cout << "Attempting Move to: (" << newRow << ", " << newCol << ")" << std::endl;
+    TRACE_DEBUG("Current Position: (" << position.first << ", " << position.second << ")");
+    TRACE_DEBUG("Attempting Move to: (" << newRow << ", " << newCol << ")");
 
     // Check if the new position is within the maze boundaries
     if (newRow < 0 || newRow >= mazeRows || newCol < 0 || newCol >= mazeCols) {
         // Debugging: Print out of bounds message
-        std::cout << "Move Invalid: New position out of bounds.("<< newRow<< ","<< mazeRows << "," << newCol<< "," << mazeCols<< ")" << std::endl;
+        TRACE_DEBUG("Move Invalid: New position out of bounds.(" << newRow << "," << mazeRows << "," << newCol << "," << mazeCols << ")");
         return false;
     }
 
     // Check if the new position is not a wall
     int cellValue = maze.at(newRow, newCol);
-    if (cellValue == 1) {  // Assuming 1 represents wall cells
+    if (!isPassable(cellValue)) {
         // Debugging: Print wall collision message along with the cell value
         // std::cout << "Move Invalid: New position (" << newRow << ", " << newCol 
         //         << ") is a wall. Cell Value: " << cellValue << std::endl;
@@ -172,14 +166,14 @@ bool QLearningAgent::isValidMove(const Maze &maze, std::pair<int, int> newPositi
 
 
     // Debugging: Print valid move message
-    std::cout << "Move Valid: New position is free." << std::endl;
+    TRACE_DEBUG("Move Valid: New position is free.");
     return true;
 }
 
 std::pair<int, int> findStartingPosition(const std::vector<std::vector<int>>& mazeGrid) {
     for (int row = 0; row < mazeGrid.size(); ++row) {
         for (int col = 0; col < mazeGrid[row].size(); ++col) {
-            if (mazeGrid[row][col] == 2) {  // 2 represents the starting position
+            if (mazeGrid[row][col] == START) {
                 return std::make_pair(row, col);
             }
         }
@@ -190,12 +184,115 @@ std::pair<int, int> findStartingPosition(const std::vector<std::vector<int>>& ma
 
 
 // Implementation of hasReachedGoal
-bool QLearningAgent::hasReachedGoal(const Maze &maze) {
-    return position.first == GOAL_ROW && position.second == GOAL_COL;
+bool QLearningAgent::hasReachedGoal(const Maze &) {
+    return position == goalPosition;
 }
 
 // Implementation of reset
 void QLearningAgent::reset() {
     position = startingPosition;
     stepsTaken = 0;
-}
\ No newline at end of file
+    // A new episode: move the exploration parameter along its schedule
+    exploration = policy.parameter(++episodes);
+}
+PlanningResult QLearningAgent::planQValues(const Maze &maze, double threshold, int maxSweeps) {
+    // Build the deterministic model the online agent sees: a blocked move stays put,
+    // and the reward is that of the cell the agent ends up in.
+    PlanningModel model;
+    model.rows = mazeRows;
+    model.cols = mazeCols;
+    model.stride = maze.rowStride();
+    model.padding = Maze::PADDING;
+    model.cellCount = static_cast<std::size_t>(mazeRows + 2 * Maze::PADDING) * model.stride;
+    const std::ptrdiff_t offsets[ACTIONS] = {1, -model.stride, -1, model.stride}; // Right, Up, Left, Down, as in calculateNewPosition
+    for (int action = 0; action < ACTIONS; ++action) {
+        model.offsets[action] = offsets[action];
+        model.open[action].assign(model.cellCount, 0.0);
+        model.reward[action].assign(model.cellCount, 0.0);
+    }
+    model.terminal.assign(model.cellCount, 1);
+
+    for (int row = 0; row < mazeRows; ++row) {
+        for (int col = 0; col < mazeCols; ++col) {
+            std::size_t cell = maze.index(row, col);
+            if (!isPassable(maze.cellAt(cell)) || maze.cellAt(cell) == GOAL) {
+                continue;  // Walls are never entered and the goal ends the episode
+            }
+            model.terminal[cell] = 0;
+            for (int action = 0; action < ACTIONS; ++action) {
+                bool open = isPassable(maze.cellAt(cell + offsets[action]));
+                std::pair<int, int> landing = open ? calculateNewPosition(std::make_pair(row, col), action) : std::make_pair(row, col);
+                model.open[action][cell] = open ? 1.0 : 0.0;
+                model.reward[action][cell] = calculateReward(maze, landing.first, landing.second);
+            }
+        }
+    }
+
+    std::vector<double> values;
+    PlanningResult result = ::planQValues(model, GAMMA, threshold, maxSweeps, values);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        Q[i] = static_cast<QValue>(values[i]);
+    }
+    return result;
+}
+
+std::vector<double> QLearningAgent::getQValues() const {
+    return std::vector<double>(Q.begin(), Q.end());
+}
+
+double QLearningAgent::maxQDifference(const std::vector<double> &reference) const {
+    double difference = 0.0;
+    for (std::size_t i = 0; i < Q.size() && i < reference.size(); ++i) {
+        difference = std::max(difference, std::fabs(static_cast<double>(Q[i]) - reference[i]));
+    }
+    return difference;
+}
+
+bool QLearningAgent::saveCheckpoint(const std::string &fileName, const Maze &maze) const {
+    QCheckpointHeader header = makeQCheckpointHeader();
+    header.mazeHash = maze.hash();
+    header.rows = static_cast<std::uint32_t>(mazeRows);
+    header.cols = static_cast<std::uint32_t>(mazeCols);
+    header.actions = ACTIONS;
+    header.valueSize = sizeof(QValue);
+    header.learningRate = ALPHA;
+    header.discountFactor = GAMMA;
+    header.explorationRate = policy.start;
+    header.explorationStrategy = static_cast<std::uint32_t>(policy.strategy);
+    header.decaySchedule = static_cast<std::uint32_t>(policy.decay);
+    header.explorationMin = policy.minimum;
+    header.decayEpisodes = static_cast<std::uint32_t>(policy.decayEpisodes);
+    header.episodes = static_cast<std::uint64_t>(episodes);
+    return writeQCheckpoint(fileName, header, Q.data());
+}
+
+bool QLearningAgent::loadCheckpoint(const std::string &fileName, const Maze &maze) {
+    QCheckpointHeader header;
+    void* values = nullptr;
+    std::shared_ptr<void> mapping = mapQCheckpoint(fileName, header, values);
+    if (!mapping) {
+        return false;
+    }
+    if (header.mazeHash != maze.hash() || header.rows != static_cast<std::uint32_t>(mazeRows) ||
+        header.cols != static_cast<std::uint32_t>(mazeCols) || header.actions != static_cast<std::uint32_t>(ACTIONS) ||
+        header.valueSize != sizeof(QValue)) {
+        std::cerr << "Error: Checkpoint " << fileName << " does not match this maze and Q-table." << std::endl;
+        return false;
+    }
+    if (header.explorationStrategy > UCB || header.decaySchedule > DECAY_EXPONENTIAL) {
+        std::cerr << "Error: Checkpoint " << fileName << " has an unknown exploration policy." << std::endl;
+        return false;
+    }
+    std::memcpy(Q.data(), values, Q.size() * sizeof(QValue));
+
+    // The schedule continues from the episodes already run, as in loadAgentCheckpoint
+    ExplorationPolicy loaded;
+    loaded.strategy = static_cast<ExplorationStrategy>(header.explorationStrategy);
+    loaded.decay = static_cast<DecaySchedule>(header.decaySchedule);
+    loaded.start = header.explorationRate;
+    loaded.minimum = header.explorationMin;
+    loaded.decayEpisodes = static_cast<int>(header.decayEpisodes);
+    episodes = static_cast<int>(header.episodes);
+    setExplorationPolicy(loaded);
+    return true;
+}
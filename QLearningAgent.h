@@ -1,52 +1,102 @@
 #ifndef QLEARNINGAGENT_H
 #define QLEARNINGAGENT_H
 
+#include <vector>
+#include <cstddef>
 #include "Agent.h"
 #include "Maze.h"  // Assuming Maze class is defined in Maze.h
+#include "AlignedAllocator.h"
+#include "Version_2/MazeElements.h"
+#include "Version_2/Random.h"
+#include "Version_2/ExplorationPolicy.h"
+#include "Version_2/DynaPlanner.h"
+#include "QPlanner.h"
+
+// Storage type for Q-values. Build with -DQLEARNING_FLOAT_Q or -DQLEARNING_HALF_Q
+// to halve or quarter the size of the Q-table on large mazes.
+#if defined(QLEARNING_HALF_Q)
+typedef _Float16 QValue;
+#elif defined(QLEARNING_FLOAT_Q)
+typedef float QValue;
+#else
+typedef double QValue;
+#endif
 
 class QLearningAgent : public Agent {
     int calculateReward(const Maze &maze, int row, int col);
 private:
-    double Q[10][10][4]; // Q-table for states and actions
+    static const int ACTIONS = 4; // Up, right, down, left
+    int mazeRows; // Rows of the maze the Q-table was sized for
+    int mazeCols; // Columns of the maze the Q-table was sized for
+    std::vector<QValue, AlignedAllocator<QValue> > Q; // Q-table, mazeRows * mazeCols * ACTIONS values
+    // Index of the first Q-value of the cell at (row, col)
+    std::size_t qIndex(int row, int col) const {
+        return (static_cast<std::size_t>(row) * mazeCols + col) * ACTIONS;
+    }
     int stepsTaken;
+    RandomGenerator rng; // Random number generator for action selection, seeded per agent
     std::pair<int, int> startingPosition;
     const double ALPHA = 0.1;  // Learning rate
     const double GAMMA = 0.9;  // Discount factor
-    const double EPSILON = 0.1;  // Exploration rate
+    const double EPSILON = 0.1;  // Exploration rate, the start of the default policy
+    ExplorationPolicy policy; // How actions are explored, epsilon-greedy at EPSILON unless set
+    double exploration; // Parameter of the policy for the current episode
+    int episodes; // Episodes started since the agent was created, counted by reset()
+    std::vector<std::uint32_t> visits; // Times each (cell, action) was chosen, kept only for UCB
+    DynaPlanner<QValue> planner; // Model of observed moves replayed after each step, when planning is on
     const int MAX_STEPS = 100;  // Maximum steps per episode
-    const int GOAL_REWARD = 10;  // Reward for reaching the goal
-    const int STEP_REWARD = -1;  // Penalty for each step
-    const int WALL_REWARD = -5;  // Penalty for hitting a wall
     // QLearningAgent.h
     int lastAction = -1; 
     // ... other includes and declarations ...
 
-    // Constants for rewards and penalties
-    const int WALL_PENALTY = -10;
-    const int GOGGLES_REWARD = 5;
-    const int SPEED_POTION_REWARD = 5;
-    const int FOG_PENALTY = -5;
-    const int SLOWPOKE_POTION_PENALTY = -5;
+    // Rewards and passability come from CELL_TYPES in MazeElements.h, shared with Version_2.
+    std::pair<int, int> goalPosition; // GOAL cell of the maze, (-1, -1) if it has none
     std::pair<int, int> calculateNewPosition(std::pair<int, int> currentPosition, int action);
     // ... QLearningAgent class declaration ...
-    std::vector<std::pair<std::pair<int, int>, int>> validMoves;
-    
-    std::vector<std::pair<std::pair<int, int>, int>> getNextPosition(const Maze &maze, std::pair<int, int> currentPosition);
 
     
     int direction;  // 0: up, 1: right, 2: down, 3: left
     int speed;
     
 public:
-    QLearningAgent(int row, int col);
+    // The seed drives action selection, so equal seeds give equal runs.
+    QLearningAgent(const Maze &maze, int row, int col, std::uint64_t seed = 1);
+    // Action chosen by the exploration policy among the valid actions of the current cell (Maze::actionMask).
     int chooseAction(const Maze &maze);
-    void updateQValues(int action, int reward, int newRow, int newCol);
+    // Use another exploration policy. Its parameter follows the policy's schedule from the
+    // episodes already run; UCB visit counts start from zero.
+    void setExplorationPolicy(const ExplorationPolicy &newPolicy);
+    // Dyna-Q: after each move, replay up to updatesPerStep moves from a learned model, those with
+    // the largest TD error first (prioritized sweeping). 0 turns planning off, as it starts.
+    void enablePlanning(const Maze &maze, int updatesPerStep, std::size_t queueCapacity = 4096);
+    // Parameter of the exploration policy for the current episode
+    double explorationParameter() const { return exploration; }
+    // Exploration policy in use and the episodes started so far
+    const ExplorationPolicy& explorationPolicy() const { return policy; }
+    int episodesStarted() const { return episodes; }
+    // Q-learning update for taking action from the current position into (newRow, newCol).
+    // The target uses the best of the new cell's validActions (Maze::actionMask), since
+    // blocked actions are never taken and their Q-values never learned.
+    void updateQValues(int action, int reward, int newRow, int newCol, unsigned validActions = 0xF);
     void move(const Maze &maze);
     void reset();  // Resets the agent to the starting position
-    bool hasReachedGoal(const Maze &maze);  // Checks if the agent has reached the goal, now taking Maze as a parameter
+    bool hasReachedGoal(const Maze &maze);  // Checks if the agent is on the maze's GOAL cell, found when it was created
     bool isValidMove(const Maze &maze, std::pair<int, int> newPosition);
-    std::pair<int, int> getNextPosition(const Maze &maze, std::pair<int, int> currentPosition, int action, int lastAction);
     int mapPositionToAction(std::pair<int, int> currentPosition, std::pair<int, int> newPosition);
+
+    // Offline planning: fill the Q-table with the optimal Q-values of the maze, found by
+    // synchronous Q-iteration over every cell. Use it to seed online learning or as a reference.
+    PlanningResult planQValues(const Maze &maze, double threshold = 1e-6, int maxSweeps = 100000);
+    // Copy of the Q-table, mazeRows * mazeCols * 4 values
+    std::vector<double> getQValues() const;
+    // Largest absolute difference between the Q-table and a reference of the same layout
+    double maxQDifference(const std::vector<double> &reference) const;
+    // Save the Q-table and hyperparameters to a checkpoint file (Version_2/QCheckpoint.h)
+    bool saveCheckpoint(const std::string &fileName, const Maze &maze) const;
+    // Load the Q-table, exploration policy and episodes run from a checkpoint made on the same
+    // maze with the same QValue type. The file is memory-mapped and its values copied in one
+    // block, without parsing. ALPHA and GAMMA are fixed, so the saved ones are not read back.
+    bool loadCheckpoint(const std::string &fileName, const Maze &maze);
     // ...
 
 };
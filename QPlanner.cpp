@@ -0,0 +1,68 @@
+#include "QPlanner.h"
+
+#include <algorithm>
+#include <cmath>
+
+PlanningResult planQValues(const PlanningModel& model, double gamma, double threshold, int maxSweeps,
+                           std::vector<double>& qValues) {
+    const int ACTIONS = PlanningModel::ACTIONS;
+    std::vector<double> value(model.cellCount, 0.0);
+    std::vector<double> nextValue(model.cellCount, 0.0);
+    std::vector<double> q[ACTIONS];
+    for (int a = 0; a < ACTIONS; ++a) {
+        q[a].assign(model.cellCount, 0.0);
+    }
+
+    PlanningResult result = {0, 0.0, false};
+    while (result.sweeps < maxSweeps) {
+        double residual = 0.0;
+
+        for (int row = 0; row < model.rows; ++row) {
+            std::size_t begin = model.index(row, 0);
+            std::size_t end = begin + model.cols;
+
+            // Q(s, a) = R(s, a) + gamma * V(s'), where s' is the neighbour if the move is open
+            // and s itself otherwise. The blend keeps the inner loop free of branches.
+            for (int a = 0; a < ACTIONS; ++a) {
+                const double* open = model.open[a].data();
+                const double* reward = model.reward[a].data();
+                const double* v = value.data();
+                const double* vNeighbour = value.data() + model.offsets[a];
+                double* qa = q[a].data();
+                for (std::size_t c = begin; c < end; ++c) {
+                    double vNext = v[c] + open[c] * (vNeighbour[c] - v[c]);
+                    qa[c] = reward[c] + gamma * vNext;
+                }
+            }
+
+            // V(s) = max_a Q(s, a), held at zero for terminal cells.
+            for (std::size_t c = begin; c < end; ++c) {
+                double best = std::max(std::max(q[0][c], q[1][c]), std::max(q[2][c], q[3][c]));
+                best = model.terminal[c] ? 0.0 : best;
+                residual = std::max(residual, std::fabs(best - value[c]));
+                nextValue[c] = best;
+            }
+        }
+
+        value.swap(nextValue);
+        result.sweeps++;
+        result.residual = residual;
+        if (residual < threshold) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    // Copy the Q-values out in the agents' layout.
+    qValues.assign(static_cast<std::size_t>(model.rows) * model.cols * ACTIONS, 0.0);
+    for (int row = 0; row < model.rows; ++row) {
+        for (int col = 0; col < model.cols; ++col) {
+            std::size_t c = model.index(row, col);
+            double* out = &qValues[(static_cast<std::size_t>(row) * model.cols + col) * ACTIONS];
+            for (int a = 0; a < ACTIONS; ++a) {
+                out[a] = model.terminal[c] ? 0.0 : q[a][c];
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,43 @@
+#ifndef QPLANNER_H
+#define QPLANNER_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Deterministic model of a maze for offline planning. Every table is laid out like the
+// maze buffer (padded, row-major) with one array per action, so a sweep over a row of
+// cells reads and writes contiguous memory.
+struct PlanningModel {
+    static const int ACTIONS = 4;
+
+    int rows; // Rows of the maze
+    int cols; // Columns of the maze
+    int stride; // Distance between vertically adjacent cells in the buffer
+    int padding; // Width of the border around the maze
+    std::size_t cellCount; // Number of cells in the padded buffer
+    std::ptrdiff_t offsets[ACTIONS]; // Buffer offset of the neighbour reached by each action
+    std::vector<double> open[ACTIONS]; // 1.0 if the action moves to its neighbour, 0.0 if it is blocked
+    std::vector<double> reward[ACTIONS]; // Reward of taking the action in the cell
+    std::vector<std::uint8_t> terminal; // 1 for cells whose value is fixed at zero (goal, walls, border)
+
+    // Buffer index of the cell at (row, col)
+    std::size_t index(int row, int col) const {
+        return static_cast<std::size_t>(row + padding) * stride + (col + padding);
+    }
+};
+
+// Result of an offline planning run.
+struct PlanningResult {
+    int sweeps; // Sweeps performed
+    double residual; // Largest value change in the final sweep
+    bool converged; // Whether the residual dropped below the threshold
+};
+
+// Run synchronous Q-iteration sweeps over the whole model until the largest value change
+// falls below threshold or maxSweeps is reached. qValues receives rows * cols * ACTIONS
+// values in the Q-table layout of the agents (cell-major, actions innermost).
+PlanningResult planQValues(const PlanningModel& model, double gamma, double threshold, int maxSweeps,
+                           std::vector<double>& qValues);
+
+#endif // QPLANNER_H
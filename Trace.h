@@ -0,0 +1,39 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <iostream>
+
+// Trace levels, from quietest to most verbose.
+#define TRACE_LEVEL_NONE 0
+#define TRACE_LEVEL_INFO 1  // Occasional progress messages
+#define TRACE_LEVEL_DEBUG 2 // Per-move and per-line details
+
+// Select the level at build time, e.g. -DTRACE_LEVEL=2.
+// Release builds (NDEBUG) default to no tracing, other builds to INFO.
+#ifndef TRACE_LEVEL
+#ifdef NDEBUG
+#define TRACE_LEVEL TRACE_LEVEL_NONE
+#else
+#define TRACE_LEVEL TRACE_LEVEL_INFO
+#endif
+#endif
+
+// True when messages of the given level are compiled in.
+#define TRACE_ENABLED(level) (TRACE_LEVEL >= (level))
+
+// Trace macros take a stream expression, e.g. TRACE_DEBUG("Row " << row).
+// Disabled levels expand to nothing, so their arguments are never evaluated.
+// Lines end with '\n' rather than std::endl so tracing does not flush per message.
+#if TRACE_ENABLED(TRACE_LEVEL_INFO)
+#define TRACE_INFO(message) do { std::cout << message << '\n'; } while (0)
+#else
+#define TRACE_INFO(message) do { } while (0)
+#endif
+
+#if TRACE_ENABLED(TRACE_LEVEL_DEBUG)
+#define TRACE_DEBUG(message) do { std::cout << message << '\n'; } while (0)
+#else
+#define TRACE_DEBUG(message) do { } while (0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,198 @@
+#include "AgentBatch.h"
+
+#include <chrono>
+
+#include "MazeElements.h"
+#include "Random.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Bit c is set when cell code c is passable, so a wall check is a shift and a mask.
+static constexpr std::uint32_t passableMask() {
+    std::uint32_t mask = 0;
+    for (int code = 0; code < MAZE_ELEMENT_COUNT; ++code) {
+        mask |= CELL_TYPES[code].passable ? (1u << code) : 0u;
+    }
+    return mask;
+}
+static const std::uint32_t PASSABLE_MASK = passableMask();
+
+void resetAgentBatch(AgentBatch& batch, const MazeGrid& maze, int count) {
+    batch.count = count;
+
+    // Number the cells holding items, so each agent can keep its own record of what it took.
+    batch.itemIndex.assign(maze.cells.size(), -1);
+    int items = 0;
+    std::int32_t start = static_cast<std::int32_t>(maze.index(0, 0));
+    for (int i = 0; i < maze.rows; ++i) {
+        for (int j = 0; j < maze.cols; ++j) {
+            int code = maze[i][j];
+            if (isConsumable(code)) {
+                batch.itemIndex[maze.index(i, j)] = items++;
+            } else if (code == START) {
+                start = static_cast<std::int32_t>(maze.index(i, j));
+            }
+        }
+    }
+    batch.itemWords = (items + 63) / 64;
+    batch.startCell = start;
+    restartAgentBatch(batch);
+}
+
+void restartAgentBatch(AgentBatch& batch) {
+    int count = batch.count;
+    batch.cell.assign(count, batch.startCell);
+    batch.direction.assign(count, EAST);
+    batch.stepSize.assign(count, 1);
+    batch.perceptField.assign(count, 1);
+    batch.active.assign(count, -1);
+    batch.steps.assign(count, 0);
+    batch.consumed.assign(static_cast<std::size_t>(count) * batch.itemWords, 0);
+}
+
+// Turn and move agents [begin, end) as turnAgent and moveAgent do. Inactive agents keep their state.
+static void turnAndMoveScalar(AgentBatch& batch, const MazeGrid& maze, const std::int32_t* actions,
+                              const std::int32_t offsets[4], int begin, int end) {
+    const std::uint8_t* cells = maze.cells.data();
+    for (int i = begin; i < end; ++i) {
+        std::int32_t active = batch.active[i];
+        std::int32_t newDirection = (batch.direction[i] + actions[i] + 2) & 0x03;
+        std::int32_t landing = batch.cell[i] + batch.stepSize[i] * offsets[newDirection];
+        std::int32_t moved = -static_cast<std::int32_t>((PASSABLE_MASK >> cells[landing]) & 1) & active;
+        batch.cell[i] = (landing & moved) | (batch.cell[i] & ~moved);
+        batch.direction[i] = (newDirection & active) | (batch.direction[i] & ~active);
+        batch.steps[i] -= active;
+    }
+}
+
+#if defined(__AVX2__)
+// Eight agents per iteration: the landing cells are gathered from the maze and checked
+// against PASSABLE_MASK with a variable shift.
+static int turnAndMoveAvx2(AgentBatch& batch, const MazeGrid& maze, const std::int32_t* actions,
+                           const std::int32_t offsets[4]) {
+    const int* cells = reinterpret_cast<const int*>(maze.cells.data());
+    const __m256i offsetTable = _mm256_setr_epi32(offsets[0], offsets[1], offsets[2], offsets[3],
+                                                  offsets[0], offsets[1], offsets[2], offsets[3]);
+    const __m256i two = _mm256_set1_epi32(2);
+    const __m256i three = _mm256_set1_epi32(3);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256i passable = _mm256_set1_epi32(static_cast<int>(PASSABLE_MASK));
+
+    int i = 0;
+    for (; i + 8 <= batch.count; i += 8) {
+        __m256i active = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&batch.active[i]));
+        __m256i direction = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&batch.direction[i]));
+        __m256i action = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&actions[i]));
+        __m256i cell = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&batch.cell[i]));
+        __m256i stepSize = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&batch.stepSize[i]));
+        __m256i steps = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&batch.steps[i]));
+
+        __m256i newDirection = _mm256_and_si256(_mm256_add_epi32(_mm256_add_epi32(direction, action), two), three);
+        __m256i offset = _mm256_permutevar8x32_epi32(offsetTable, newDirection);
+        __m256i landing = _mm256_add_epi32(cell, _mm256_mullo_epi32(stepSize, offset));
+
+        // The maze ends in MAZE_PADDING wall rows, so the 4-byte gather stays inside the buffer.
+        __m256i code = _mm256_and_si256(_mm256_i32gather_epi32(cells, landing, 1), byteMask);
+        __m256i open = _mm256_and_si256(_mm256_srlv_epi32(passable, code), one);
+        __m256i moved = _mm256_and_si256(_mm256_cmpeq_epi32(open, one), active);
+
+        cell = _mm256_blendv_epi8(cell, landing, moved);
+        direction = _mm256_blendv_epi8(direction, newDirection, active);
+        steps = _mm256_sub_epi32(steps, active);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&batch.cell[i]), cell);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&batch.direction[i]), direction);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&batch.steps[i]), steps);
+    }
+    return i;
+}
+#endif
+
+int stepAgentBatch(AgentBatch& batch, const MazeGrid& maze, const std::int32_t* actions) {
+    std::int32_t offsets[4];
+    for (int direction = 0; direction < 4; ++direction) {
+        offsets[direction] = static_cast<std::int32_t>(maze.directionOffset(direction));
+    }
+
+    int done = 0;
+#if defined(__AVX2__)
+    done = turnAndMoveAvx2(batch, maze, actions, offsets);
+#endif
+    turnAndMoveScalar(batch, maze, actions, offsets, done, batch.count);
+
+    // Items and the goal, as updateAgentState does. Only agents standing on an item or the
+    // goal take a branch.
+    int running = 0;
+    for (int i = 0; i < batch.count; ++i) {
+        if (!batch.active[i]) {
+            continue;
+        }
+        int code = maze.cells[batch.cell[i]];
+        if (isConsumable(code)) {
+            std::int32_t item = batch.itemIndex[batch.cell[i]];
+            std::uint64_t& word = batch.consumed[static_cast<std::size_t>(i) * batch.itemWords + item / 64];
+            std::uint64_t bit = std::uint64_t(1) << (item % 64);
+            if (!(word & bit)) {
+                word |= bit;
+                batch.stepSize[i] = stepSizeAfter(batch.stepSize[i], code);
+                batch.perceptField[i] = perceptFieldAfter(batch.perceptField[i], code);
+            }
+        } else if (code == GOAL) {
+            batch.active[i] = 0;
+            continue;
+        }
+        running++;
+    }
+    return running;
+}
+
+Position agentBatchPosition(const AgentBatch& batch, const MazeGrid& maze, int agent) {
+    Position position;
+    position.x = batch.cell[agent] / maze.stride - MAZE_PADDING;
+    position.y = batch.cell[agent] % maze.stride - MAZE_PADDING;
+    return position;
+}
+
+BatchEvaluation evaluatePolicy(const QTable& qTable, const MazeGrid& maze, int agents,
+                               const ExplorationPolicy& policy, double parameter, int maxSteps, std::uint64_t seed) {
+    auto startTime = std::chrono::steady_clock::now();
+    BatchEvaluation evaluation = {agents, 0, 0.0, 0, 0.0};
+
+    AgentBatch batch;
+    resetAgentBatch(batch, maze, agents);
+    RandomGenerator rng(seed);
+    std::vector<std::int32_t> actions(agents, 2);
+
+    double choiceParameter = policy.strategy == UCB ? 0.0 : parameter;
+    int actionCount = qTable.getActions();
+    unsigned allActions = (1u << actionCount) - 1;
+
+    int running = agents;
+    for (int step = 0; step < maxSteps && running > 0; ++step) {
+        // Choice per agent through the policy, as decideNextAction makes it.
+        for (int i = 0; i < agents; ++i) {
+            if (!batch.active[i]) {
+                continue;
+            }
+            Position position = agentBatchPosition(batch, maze, i);
+            actions[i] = policy.choose(qTable.row(position.x, position.y), actionCount, allActions, choiceParameter,
+                                       nullptr, rng) + 1;
+        }
+        running = stepAgentBatch(batch, maze, actions.data());
+    }
+
+    long long goalSteps = 0;
+    for (int i = 0; i < agents; ++i) {
+        evaluation.totalSteps += batch.steps[i];
+        if (!batch.active[i]) {
+            evaluation.goalsReached++;
+            goalSteps += batch.steps[i];
+        }
+    }
+    evaluation.meanSteps = evaluation.goalsReached > 0 ? static_cast<double>(goalSteps) / evaluation.goalsReached : 0.0;
+    evaluation.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return evaluation;
+}
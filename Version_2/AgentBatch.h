@@ -0,0 +1,65 @@
+#ifndef AGENTBATCH_H
+#define AGENTBATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Agent.h"
+#include "MazeGrid.h"
+#include "QTable.h"
+
+// Many agents on one maze, stored as struct-of-arrays so a step of the whole batch runs as
+// a few tight loops over contiguous arrays instead of N scattered Agent structs.
+// The turn and wall-check kernels use AVX2 when the build enables it (-mavx2 or /arch:AVX2)
+// and a branch-free scalar loop otherwise. Each agent takes items for itself only; the maze
+// is never modified.
+struct AgentBatch {
+    int count = 0; // Number of agents
+    std::vector<std::int32_t> cell; // Buffer index of each agent's cell in the maze
+    std::vector<std::int32_t> direction; // Direction of each agent (NORTH, EAST, SOUTH, WEST)
+    std::vector<std::int32_t> stepSize; // Step size of each agent
+    std::vector<std::int32_t> perceptField; // Perceptual field of each agent
+    std::vector<std::int32_t> active; // -1 while the agent runs, 0 once it has reached GOAL
+    std::vector<std::int32_t> steps; // Steps taken by each agent
+    std::vector<std::int32_t> itemIndex; // Item number of each maze cell holding an item, -1 for other cells
+    std::int32_t startCell = 0; // Buffer index of the START cell
+    int itemWords = 0; // 64-bit words of item bits per agent
+    std::vector<std::uint64_t> consumed; // Items taken, itemWords words per agent
+};
+
+// Outcome of running a policy with a batch of agents.
+struct BatchEvaluation {
+    int agents; // Agents run
+    int goalsReached; // Agents that reached GOAL within the step limit
+    double meanSteps; // Mean steps of the agents that reached GOAL, 0 if none did
+    long long totalSteps; // Steps taken by all agents together
+    double seconds; // Wall-clock time of the run
+};
+
+// Function to place count agents on START, facing EAST with stepSize and perceptField 1,
+// as initializeAgent does.
+void resetAgentBatch(AgentBatch& batch, const MazeGrid& maze, int count);
+
+// Function to put every agent of the batch back on START as resetAgentBatch does, with no
+// items taken. The item numbering of the maze is kept, so the maze is not scanned again.
+void restartAgentBatch(AgentBatch& batch);
+
+// Function to advance every running agent by one action (1 - Turn Left, 2 - Forward,
+// 3 - Turn Right, each then forward; actions[i] is for agent i). Moves follow turnAgent,
+// moveAgent and updateAgentState; agents that reach GOAL stop. Returns the number of
+// agents still running.
+int stepAgentBatch(AgentBatch& batch, const MazeGrid& maze, const std::int32_t* actions);
+
+// Function to get the (row, col) position of one agent of the batch.
+Position agentBatchPosition(const AgentBatch& batch, const MazeGrid& maze, int agent);
+
+// Function to run agents from START with an exploration policy over a Q-table, one step of
+// the whole batch at a time, until all reach GOAL or maxSteps is reached. parameter is the
+// policy's parameter (epsilon, temperature or c). UCB takes the best action: its bonus comes
+// from the visit counts of training, which the evaluation agents do not have. Steps count one per
+// action as in runEpisode, but the agents choose their first action rather than opening with
+// runEpisode's forward move.
+BatchEvaluation evaluatePolicy(const QTable& qTable, const MazeGrid& maze, int agents,
+                               const ExplorationPolicy& policy, double parameter, int maxSteps, std::uint64_t seed);
+
+#endif // AGENTBATCH_H
@@ -4,21 +4,27 @@
 #include <vector>
 #include <string>
 #include <map>
+#include "MazeGrid.h"
 #include "Agent.h"  // Assuming Agent.h contains the definition of the Agent struct and related enums.
 
 // Function to initialize the agent with initial settings and QTable.
-Agent initializeAgent(const std::vector<std::vector<int>>& maze);
+// The seed drives the agent's exploration, so equal seeds give equal runs.
+Agent initializeAgent(const MazeGrid& maze, std::uint64_t seed = 1);
+
+// Function to put the agent back on the START cell for a new episode, keeping its QTable.
+void resetAgent(Agent& agent, const MazeGrid& maze);
 
 // Function to move the agent in the direction it is facing.
-bool moveAgent(Agent& agent, const std::vector<std::vector<int>>& maze);
+bool moveAgent(Agent& agent, const MazeGrid& maze);
 
 // Function to turn the agent based on a turn command.
 void turnAgent(Agent& agent, int turnCommand);
 
 // Function to update the agent's state based on its current position in the maze.
-void updateAgentState(Agent& agent, std::vector<std::vector<int>>& maze);
+// Items picked up are recorded in the maze so maze.restoreItems() can put them back.
+void updateAgentState(Agent& agent, MazeGrid& maze);
 
 // Function to decide the next action for the agent based on its current state and the maze.
-int decideNextAction(Agent& agent, const std::vector<std::vector<int>>& maze);
+int decideNextAction(Agent& agent, const MazeGrid& maze);
 
 #endif // AGENTUTILS_H
@@ -0,0 +1,99 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness in the style of Google Benchmark: each benchmark is run with a
+// growing iteration count until it takes at least the minimum time, then reported on the
+// console and, if requested, to a JSON file in the Google Benchmark output format so results
+// from different commits can be compared with its tools.
+
+// Timing of one benchmark.
+struct BenchmarkResult {
+    std::string name; // Benchmark name, e.g. "BM_MoveAgent/maze.txt"
+    long long iterations; // Iterations in the timed run
+    double seconds; // Wall time of the timed run
+    double itemsPerSecond; // Items processed per second (steps, loads, ...)
+};
+
+class BenchmarkRunner {
+public:
+    explicit BenchmarkRunner(double minTime = 0.5) : minTime(minTime) {}
+
+    // Run a benchmark. body(iterations) performs that many iterations and returns the
+    // number of items processed.
+    template <typename Body>
+    const BenchmarkResult& run(const std::string& name, Body body) {
+        long long iterations = 1;
+        for (;;) {
+            auto startTime = std::chrono::steady_clock::now();
+            long long items = body(iterations);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+            if (seconds >= minTime || iterations >= (1LL << 40)) {
+                results.push_back({name, iterations, seconds, seconds > 0 ? items / seconds : 0.0});
+                report(results.back());
+                return results.back();
+            }
+            // Aim past the minimum time, growing at most tenfold per round.
+            long long next = seconds > 0 ? static_cast<long long>(iterations * minTime * 1.4 / seconds) : iterations * 10;
+            iterations = next > iterations * 10 ? iterations * 10 : (next > iterations ? next : iterations + 1);
+        }
+    }
+
+    // Write all results as Google Benchmark JSON. Returns false if the file cannot be written.
+    bool writeJson(const std::string& fileName, const std::string& executable) const {
+        std::FILE* file = std::fopen(fileName.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        std::fprintf(file, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"executable\": \"%s\",\n", date, executable.c_str());
+        std::fprintf(file, "    \"library_build_type\": \"%s\"\n  },\n  \"benchmarks\": [\n",
+#ifdef NDEBUG
+                     "release"
+#else
+                     "debug"
+#endif
+        );
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& result = results[i];
+            double nanoseconds = result.seconds * 1e9 / result.iterations;
+            std::fprintf(file, "    {\n      \"name\": \"%s\",\n      \"run_type\": \"iteration\",\n", result.name.c_str());
+            std::fprintf(file, "      \"iterations\": %lld,\n      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n",
+                         result.iterations, nanoseconds, nanoseconds);
+            std::fprintf(file, "      \"time_unit\": \"ns\",\n      \"items_per_second\": %.3f\n    }%s\n",
+                         result.itemsPerSecond, i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+
+private:
+    static void report(const BenchmarkResult& result) {
+        std::printf("%-48s %14.1f ns %12lld %12.4g items/s\n", result.name.c_str(),
+                    result.seconds * 1e9 / result.iterations, result.iterations, result.itemsPerSecond);
+        std::fflush(stdout);
+    }
+
+    double minTime; // Minimum wall time of a timed run, in seconds
+    std::vector<BenchmarkResult> results; // Results in the order the benchmarks ran
+};
+
+// Keep a computed value alive so the optimizer cannot drop the work that produced it.
+inline void doNotOptimize(long long value) {
+    static volatile long long sink;
+    sink = value;
+    (void)sink;
+}
+
+#endif // BENCHMARK_H
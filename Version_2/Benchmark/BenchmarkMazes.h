@@ -0,0 +1,31 @@
+#ifndef BENCHMARKMAZES_H
+#define BENCHMARKMAZES_H
+
+#include <string>
+
+#include "../MazeGrid.h"
+#include "../MazeGenerator.h"
+
+// Mazes shared by the benchmark programs, so every commit is measured on the same input.
+
+// Function to build the generated benchmark maze of the given size: a braid maze, so agents
+// can wander through loops, with 2% items. Equal seeds give equal mazes.
+inline MazeGrid makeBenchmarkMaze(int rows, int cols, std::uint64_t seed) {
+    MazeGeneratorOptions options;
+    options.rows = rows;
+    options.cols = cols;
+    options.algorithm = BRAID;
+    options.seed = seed;
+    options.itemDensity = 0.02;
+    MazeGrid maze = generateMaze(options);
+    maze.buildMoves();
+    return maze;
+}
+
+// Name of a maze file without its directories, for benchmark names.
+inline std::string benchmarkMazeName(const std::string& fileName) {
+    std::size_t slash = fileName.find_last_of("/\\");
+    return slash == std::string::npos ? fileName : fileName.substr(slash + 1);
+}
+
+#endif // BENCHMARKMAZES_H
@@ -0,0 +1,195 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../Benchmark.h"
+#include "BenchmarkMazes.h"
+#include "../QTable.cpp"
+#include "../BufferedWriter.cpp"
+#include "../MazeBinary.cpp"
+#include "../MazeGenerator.cpp"
+#include "../MazeUtils.cpp"
+#include "../AgentUtils.cpp"
+#include "../AgentBatch.cpp"
+
+// Measures step throughput of the Version_2 agent and maze load times, and writes the results
+// as Google Benchmark JSON so runs from different commits can be compared.
+// Usage: benchmark [--out results.json] [--min-time seconds] [--generated size ...] [maze files ...]
+// Without maze files the checked-in test mazes are used. Generated mazes default to 256 and 2048.
+
+// Maze under test, with the text and binary files it is loaded from.
+struct BenchmarkMaze {
+    std::string name; // Name used in benchmark names
+    std::string textFile; // Text version of the maze
+    std::string binaryFile; // Binary version of the maze, written for the run
+    bool temporaryText; // Whether the text file was written for the run
+    MazeGrid grid; // The maze as loaded
+};
+
+// Random walk with turnAgent, moveAgent and updateAgentState, starting over at GOAL.
+static void benchmarkMoveAgent(BenchmarkRunner& runner, BenchmarkMaze& maze) {
+    Agent agent = initializeAgent(maze.grid, 1);
+    RandomGenerator rng(2);
+    runner.run("BM_MoveAgent/" + maze.name, [&](long long iterations) {
+        for (long long i = 0; i < iterations; ++i) {
+            turnAgent(agent, rng.nextBelow(3) + 1);
+            moveAgent(agent, maze.grid);
+            updateAgentState(agent, maze.grid);
+            if (maze.grid[agent.position.x][agent.position.y] == GOAL) {
+                maze.grid.restoreItems();
+                resetAgent(agent, maze.grid);
+            }
+        }
+        return iterations;
+    });
+    maze.grid.restoreItems();
+}
+
+// Random actions for a batch of agents stepped in lockstep. Items are agent steps.
+static void benchmarkAgentBatch(BenchmarkRunner& runner, BenchmarkMaze& maze, int agents) {
+    AgentBatch batch;
+    resetAgentBatch(batch, maze.grid, agents);
+    RandomGenerator rng(4);
+    std::vector<std::int32_t> actions(static_cast<std::size_t>(agents) * 64);
+    for (std::int32_t& action : actions) {
+        action = static_cast<std::int32_t>(rng.nextBelow(3)) + 1;
+    }
+
+    runner.run("BM_AgentBatchStep/" + maze.name + "/" + std::to_string(agents), [&](long long iterations) {
+        for (long long i = 0; i < iterations; ++i) {
+            int running = stepAgentBatch(batch, maze.grid, &actions[static_cast<std::size_t>(i & 63) * agents]);
+            if (running < agents / 2) {
+                // Only the agents start over; the maze's item numbering is kept out of the timing
+                restartAgentBatch(batch);
+            }
+        }
+        return iterations * agents;
+    });
+}
+
+// decideNextAction from positions along a random walk, so the Q-table is read across the maze.
+static void benchmarkDecideNextAction(BenchmarkRunner& runner, BenchmarkMaze& maze) {
+    Agent agent = initializeAgent(maze.grid, 1);
+    RandomGenerator rng(3);
+    std::vector<Position> positions;
+    for (int i = 0; i < 4096; ++i) {
+        turnAgent(agent, rng.nextBelow(3) + 1);
+        moveAgent(agent, maze.grid);
+        positions.push_back(agent.position);
+    }
+    for (int i = 0; i < maze.grid.rows; ++i) {
+        for (int j = 0; j < maze.grid.cols; ++j) {
+            for (int action = 0; action < agent.qTable.getActions(); ++action) {
+                agent.qTable.at(i, j, action) = rng.nextDouble();
+            }
+        }
+    }
+
+    runner.run("BM_DecideNextAction/" + maze.name, [&](long long iterations) {
+        long long checksum = 0;
+        for (long long i = 0; i < iterations; ++i) {
+            agent.position = positions[i & 4095];
+            checksum += decideNextAction(agent, maze.grid);
+        }
+        doNotOptimize(checksum);
+        return iterations;
+    });
+}
+
+// Loading the maze from a file. Items are cells per second.
+static void benchmarkLoad(BenchmarkRunner& runner, const std::string& name, const std::string& fileName) {
+    runner.run(name, [&](long long iterations) {
+        long long cells = 0;
+        for (long long i = 0; i < iterations; ++i) {
+            MazeGrid loaded = readMaze(fileName);
+            cells += static_cast<long long>(loaded.rows) * loaded.cols;
+        }
+        return cells;
+    });
+}
+
+int main(int argc, char* argv[]) {
+    std::string outFile = "benchmark_results.json";
+    double minTime = 0.5;
+    std::vector<int> generatedSizes;
+    std::vector<std::string> mazeFiles;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outFile = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (arg == "--generated" && i + 1 < argc) {
+            generatedSizes.push_back(std::atoi(argv[++i]));
+        } else {
+            mazeFiles.push_back(arg);
+        }
+    }
+    if (mazeFiles.empty()) {
+        mazeFiles = {"../maze.txt", "../../maze_testrun_1_newlines.txt", "../../maze_testrun_2_newlines.txt", "../../maze_testrun_3.json"};
+    }
+    if (generatedSizes.empty()) {
+        generatedSizes = {256, 2048};
+    }
+
+    // Load the mazes and write the files each format is loaded from.
+    std::vector<BenchmarkMaze> mazes;
+    for (const std::string& fileName : mazeFiles) {
+        BenchmarkMaze maze = {benchmarkMazeName(fileName), fileName, "", false, readMaze(fileName)};
+        if (maze.grid.empty()) {
+            std::cerr << "Error: Failed to load maze " << fileName << std::endl;
+            continue;
+        }
+        mazes.push_back(maze);
+    }
+    for (int size : generatedSizes) {
+        if (size <= 0) {
+            continue;
+        }
+        std::string name = "generated_" + std::to_string(size) + "x" + std::to_string(size);
+        BenchmarkMaze maze = {name, name + ".bench.txt", "", true, makeBenchmarkMaze(size, size, size)};
+        if (!writeMazeText(maze.textFile, maze.grid)) {
+            std::cerr << "Error: Failed to write " << maze.textFile << std::endl;
+            continue;
+        }
+        mazes.push_back(maze);
+    }
+    for (BenchmarkMaze& maze : mazes) {
+        maze.binaryFile = maze.name + ".bench.mzb";
+        if (!writeMazeBinary(maze.binaryFile, maze.grid)) {
+            std::cerr << "Error: Failed to write " << maze.binaryFile << std::endl;
+            maze.binaryFile.clear();
+        }
+    }
+
+    BenchmarkRunner runner(minTime);
+    for (BenchmarkMaze& maze : mazes) {
+        benchmarkMoveAgent(runner, maze);
+        benchmarkAgentBatch(runner, maze, 4096);
+        benchmarkDecideNextAction(runner, maze);
+        if (!isMazeBinaryFile(maze.textFile)) {
+            benchmarkLoad(runner, "BM_LoadText/" + maze.name, maze.textFile);
+        }
+        if (!maze.binaryFile.empty()) {
+            benchmarkLoad(runner, "BM_LoadBinary/" + maze.name, maze.binaryFile);
+        }
+    }
+
+    for (const BenchmarkMaze& maze : mazes) {
+        if (maze.temporaryText) {
+            std::remove(maze.textFile.c_str());
+        }
+        if (!maze.binaryFile.empty()) {
+            std::remove(maze.binaryFile.c_str());
+        }
+    }
+
+    if (!runner.writeJson(outFile, argv[0])) {
+        std::cerr << "Error: Failed to write " << outFile << std::endl;
+        return 1;
+    }
+    std::cout << "Results written to " << outFile << std::endl;
+    return 0;
+}
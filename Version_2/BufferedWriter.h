@@ -0,0 +1,41 @@
+#ifndef BUFFEREDWRITER_H
+#define BUFFEREDWRITER_H
+
+#include <cstdio>
+#include <cstddef>
+#include <string>
+
+// Output writer that collects text in a buffer and hands it to the stream in large
+// chunks, so rendering a maze costs one write instead of one per cell.
+class BufferedWriter {
+public:
+    explicit BufferedWriter(std::FILE* stream, std::size_t capacity = 1 << 16);
+    ~BufferedWriter();
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void write(const char* data, std::size_t length);
+    void put(char ch) {
+        buffer.push_back(ch);
+        if (buffer.size() >= capacity) {
+            flush();
+        }
+    }
+
+    // Write the buffered text to the stream.
+    void flush();
+
+    BufferedWriter& operator<<(char ch) { put(ch); return *this; }
+    BufferedWriter& operator<<(const char* text);
+    BufferedWriter& operator<<(const std::string& text);
+    BufferedWriter& operator<<(int value);
+    BufferedWriter& operator<<(long long value);
+    BufferedWriter& operator<<(double value);
+
+private:
+    std::FILE* stream; // Destination of the buffered text
+    std::size_t capacity; // Buffer size that triggers a flush
+    std::string buffer; // Text not yet written
+};
+
+#endif // BUFFEREDWRITER_H
@@ -0,0 +1,180 @@
+#ifndef DYNAPLANNER_H
+#define DYNAPLANNER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// Dyna-Q with prioritized sweeping, for a dense Q-table of rows * cols cells with a fixed
+// number of actions per cell. Cells are numbered row * cols + col, as in the Q-table.
+//
+// The model keeps, for every (cell, action), the cell the action last led to and the reward
+// it gave: 8 bytes per pair, in one array laid out like the Q-table. After each real step the
+// pairs whose Q-value is out of date are queued by the magnitude of their TD error: the step
+// itself, and the pairs the model says lead into the cell whose values just changed. The
+// largest errors are then replayed from the model, each replay queuing the pairs that lead
+// into its own cell in turn.
+//
+// Moves are straight lines of at most reach cells, so the pairs leading into a cell are found
+// by looking at the cells in line with it rather than by keeping lists of predecessors.
+// Value is the type of the Q-values.
+template <class Value>
+class DynaPlanner {
+public:
+    DynaPlanner() : rows(0), cols(0), actions(0), reach(0), updatesPerStep(0), capacity(0), threshold(1e-4) {}
+
+    // Size the model for a rows x cols maze and clear it. Moves span at most maxMove cells.
+    // Each real step is followed by up to updates planning updates; 0 turns planning off and
+    // frees the model. The queue keeps at least queueCapacity of the largest errors, and at
+    // most twice as many.
+    void resize(int mazeRows, int mazeCols, int actionCount, int maxMove, int updates, std::size_t queueCapacity) {
+        rows = mazeRows;
+        cols = mazeCols;
+        actions = actionCount;
+        reach = maxMove;
+        updatesPerStep = updates;
+        capacity = std::max<std::size_t>(queueCapacity, 1);
+        Transition unvisited = {UNVISITED, 0, 0, 0};
+        model.assign(updates > 0 ? static_cast<std::size_t>(rows) * cols * actions : 0, unvisited);
+        queue.clear();
+        queue.reserve(updates > 0 ? 2 * capacity : 0);
+    }
+
+    // Restrict the targets to the actions that can be taken: bit action of masks[cell] is set
+    // for each. Without masks every action counts.
+    void setActionMasks(const std::vector<std::uint8_t>& cellMasks) { masks = cellMasks; }
+
+    bool enabled() const { return updatesPerStep > 0; }
+
+    // Learn from a real step, taken from cell with action into next for reward, once the
+    // Q-table has been updated for it; then run the planning updates. Returns how many ran.
+    int update(Value* q, std::size_t cell, int action, std::size_t next, int reward, double alpha, double gamma) {
+        Transition& transition = model[cell * actions + action];
+        transition.next = static_cast<std::uint32_t>(next);
+        transition.reward = static_cast<std::int16_t>(reward);
+        push(q, cell * actions + action, gamma);
+        pushPredecessors(q, cell, gamma);
+
+        int planned = 0;
+        while (planned < updatesPerStep && !queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end());
+            std::uint32_t pair = queue.back().pair;
+            queue.pop_back();
+
+            Transition& replayed = model[pair];
+            replayed.queued = 0;
+            Value& value = q[pair];
+            value = static_cast<Value>(value + alpha * (replayed.reward + gamma * maxValue(q, replayed.next) - value));
+            ++planned;
+            pushPredecessors(q, pair / actions, gamma);
+        }
+        return planned;
+    }
+
+    // Pairs waiting in the queue.
+    std::size_t queued() const { return queue.size(); }
+
+private:
+    // Model entry of one (cell, action).
+    struct Transition {
+        std::uint32_t next; // Cell the action last led to, UNVISITED if never taken
+        std::int16_t reward; // Reward it gave
+        std::uint8_t queued; // Whether the pair is in the queue
+        std::uint8_t reserved; // Zero
+    };
+    static_assert(sizeof(Transition) == 8, "Model entries must stay 8 bytes");
+
+    // Queue entry, ordered by priority.
+    struct Entry {
+        float priority; // Magnitude of the TD error when queued
+        std::uint32_t pair; // cell * actions + action
+        bool operator<(const Entry& other) const { return priority < other.priority; }
+    };
+
+    static const std::uint32_t UNVISITED = 0xFFFFFFFFu;
+
+    // Highest Q-value of the actions that can be taken in a cell, 0 if there are none.
+    double maxValue(const Value* q, std::size_t cell) const {
+        const Value* row = q + cell * actions;
+        unsigned mask = masks.empty() ? ~0u : masks[cell];
+        bool found = false;
+        double best = 0.0;
+        for (int action = 0; action < actions; ++action) {
+            if ((mask >> action & 1) && (!found || static_cast<double>(row[action]) > best)) {
+                best = static_cast<double>(row[action]);
+                found = true;
+            }
+        }
+        return best;
+    }
+
+    // Queue a pair the model has seen if its TD error is above the threshold. A pair already
+    // in the queue keeps its place: its update reads the Q-values when it is made, not queued.
+    void push(const Value* q, std::size_t pair, double gamma) {
+        Transition& transition = model[pair];
+        if (transition.next == UNVISITED || transition.queued) {
+            return;
+        }
+        double error = std::fabs(transition.reward + gamma * maxValue(q, transition.next) - static_cast<double>(q[pair]));
+        if (error <= threshold) {
+            return;
+        }
+        transition.queued = 1;
+        queue.push_back({static_cast<float>(error), static_cast<std::uint32_t>(pair)});
+        std::push_heap(queue.begin(), queue.end());
+        if (queue.size() >= 2 * capacity) {
+            // Keep the largest errors; the rest are dropped in one pass rather than one at a time.
+            std::nth_element(queue.begin(), queue.begin() + capacity, queue.end(),
+                             [](const Entry& a, const Entry& b) { return b < a; });
+            for (std::size_t i = capacity; i < queue.size(); ++i) {
+                model[queue[i].pair].queued = 0;
+            }
+            queue.resize(capacity);
+            std::make_heap(queue.begin(), queue.end());
+        }
+    }
+
+    // Queue the pairs of the cells in line with cell, and of cell itself, that lead into it.
+    void pushPredecessors(const Value* q, std::size_t cell, double gamma) {
+        static const int ROW_STEP[4] = {-1, 0, 1, 0};
+        static const int COL_STEP[4] = {0, 1, 0, -1};
+        int row = static_cast<int>(cell / cols);
+        int col = static_cast<int>(cell % cols);
+        pushInto(q, cell, cell, gamma); // Blocked moves stay on the cell
+        for (int direction = 0; direction < 4; ++direction) {
+            for (int distance = 1; distance <= reach; ++distance) {
+                int fromRow = row + distance * ROW_STEP[direction];
+                int fromCol = col + distance * COL_STEP[direction];
+                if (fromRow < 0 || fromRow >= rows || fromCol < 0 || fromCol >= cols) {
+                    break;
+                }
+                pushInto(q, static_cast<std::size_t>(fromRow) * cols + fromCol, cell, gamma);
+            }
+        }
+    }
+
+    // Queue the pairs of cell from whose model entry leads into cell to.
+    void pushInto(const Value* q, std::size_t from, std::size_t to, double gamma) {
+        for (int action = 0; action < actions; ++action) {
+            std::size_t pair = from * actions + action;
+            if (model[pair].next == to) {
+                push(q, pair, gamma);
+            }
+        }
+    }
+
+    int rows; // Rows of the maze
+    int cols; // Columns of the maze
+    int actions; // Actions per cell
+    int reach; // Longest move in cells
+    int updatesPerStep; // Planning updates after each real step
+    std::size_t capacity; // Entries kept when the queue is trimmed
+    double threshold; // Smallest TD error worth queuing
+    std::vector<Transition> model; // Learned model, one entry per (cell, action)
+    std::vector<std::uint8_t> masks; // Actions that can be taken in each cell, empty for all
+    std::vector<Entry> queue; // Max-heap of pairs to update, by TD error
+};
+
+#endif // DYNAPLANNER_H
@@ -0,0 +1,93 @@
+#ifndef ELIGIBILITYTRACES_H
+#define ELIGIBILITYTRACES_H
+
+#include <cstddef>
+#include <vector>
+
+// Eligibility traces for Watkins Q(lambda) over a dense Q-table.
+// Only the recently taken (cell, action) pairs have a trace worth keeping, so the traces live
+// in a ring of at most capacity entries, newest last, instead of a table the size of the
+// Q-table. Every trace decays by the same factor each step, so the oldest is always the
+// smallest: traces that fall below the cutoff leave from the old end, and when the ring is
+// full the oldest is dropped. A step costs at most capacity updates however large the maze.
+class EligibilityTraces {
+public:
+    EligibilityTraces() : lambda(0.0), cutoff(0.01), first(0), count(0) {}
+
+    // Use trace decay lambda (0 turns traces off) and keep at most capacity traces,
+    // dropping those below cutoff.
+    void configure(double traceDecay, std::size_t capacity, double traceCutoff = 0.01) {
+        lambda = traceDecay;
+        cutoff = traceCutoff;
+        ring.assign(lambda > 0.0 ? (capacity > 0 ? capacity : 1) : 0, Trace());
+        clear();
+    }
+
+    bool enabled() const { return lambda > 0.0; }
+
+    // Forget every trace, at the start of an episode.
+    void clear() {
+        first = 0;
+        count = 0;
+    }
+
+    // Number of traces kept.
+    std::size_t size() const { return count; }
+
+    // Watkins Q(lambda) update for taking the Q-table entry pair, whose TD error is delta:
+    // every traced entry moves by alpha * delta * trace, the pair's trace being 1. greedy
+    // tells whether the action was the best one in its cell; after an exploratory action the
+    // earlier steps no longer lead along the greedy policy, so their traces are cut.
+    void update(double* q, std::size_t pair, double delta, double alpha, double gamma, bool greedy) {
+        if (!greedy) {
+            clear();
+        }
+
+        // Replacing traces: a pair taken again restarts at 1 instead of adding up, so its
+        // older entry is emptied and left to leave the ring with its neighbours.
+        for (std::size_t i = 0; i < count; ++i) {
+            Trace& trace = at(i);
+            if (trace.pair == pair) {
+                trace.value = 0.0;
+            }
+        }
+        if (count == ring.size()) {
+            first = (first + 1) % ring.size();
+            --count;
+        }
+        Trace& newest = at(count++);
+        newest.pair = pair;
+        newest.value = 1.0;
+
+        // Credit every traced entry, then decay the traces and drop the ones below the cutoff.
+        double step = alpha * delta;
+        double decay = gamma * lambda;
+        for (std::size_t i = 0; i < count; ++i) {
+            Trace& trace = at(i);
+            q[trace.pair] += step * trace.value;
+            trace.value *= decay;
+        }
+        while (count > 0 && at(0).value < cutoff) {
+            first = (first + 1) % ring.size();
+            --count;
+        }
+    }
+
+private:
+    // Trace of one Q-table entry.
+    struct Trace {
+        std::size_t pair = 0; // Index of the entry in the Q-table
+        double value = 0.0; // Eligibility of the entry
+    };
+
+    // The i-th trace, oldest first.
+    Trace& at(std::size_t i) { return ring[(first + i) % ring.size()]; }
+
+    double lambda; // Trace decay per step, on top of the discount factor
+    double cutoff; // Smallest trace kept
+    std::vector<Trace> ring; // Traces, oldest at first
+    std::size_t first; // Position of the oldest trace in ring
+    std::size_t count; // Number of traces kept
+};
+
+#endif // ELIGIBILITYTRACES_H
@@ -0,0 +1,170 @@
+#ifndef EXPLORATIONPOLICY_H
+#define EXPLORATIONPOLICY_H
+
+#include <cstdint>
+#include <cmath>
+#include <string>
+
+#include "Random.h"
+
+// How an agent trades exploring against taking the best known action.
+enum ExplorationStrategy {
+    EPSILON_GREEDY, // A random action with probability epsilon, else the best one
+    SOFTMAX,        // Actions drawn with probability exp(Q / temperature), Boltzmann exploration
+    UCB             // The action with the highest Q + c * sqrt(ln N(cell) / N(cell, action))
+};
+
+// How the exploration parameter changes from episode to episode.
+enum DecaySchedule {
+    DECAY_CONSTANT,   // Stays at its start value
+    DECAY_LINEAR,     // Falls in a straight line to its minimum over decayEpisodes
+    DECAY_EXPONENTIAL // Falls toward its minimum, closing a factor e of the gap every decayEpisodes
+};
+
+// Largest number of actions a policy chooses between.
+const int MAX_POLICY_ACTIONS = 4;
+
+// Exploration policy shared by QLearningAgent and Version_2 agents.
+// The parameter is epsilon for EPSILON_GREEDY, the temperature for SOFTMAX and the
+// constant c for UCB; a parameter of 0 always takes the best action.
+struct ExplorationPolicy {
+    ExplorationStrategy strategy = EPSILON_GREEDY;
+    DecaySchedule decay = DECAY_CONSTANT;
+    double start = 0.1; // Parameter for the first episode
+    double minimum = 0.0; // Parameter the schedule decays to
+    int decayEpisodes = 1000; // Length of the decay, see DecaySchedule
+
+    // Parameter for an episode, counting trained episodes from 0.
+    double parameter(int episode) const {
+        if (decay == DECAY_LINEAR) {
+            double remaining = decayEpisodes > 0 ? 1.0 - static_cast<double>(episode) / decayEpisodes : 0.0;
+            return minimum + (start - minimum) * (remaining > 0.0 ? remaining : 0.0);
+        }
+        if (decay == DECAY_EXPONENTIAL) {
+            return decayEpisodes > 0 ? minimum + (start - minimum) * std::exp(-static_cast<double>(episode) / decayEpisodes)
+                                     : minimum;
+        }
+        return start;
+    }
+
+    // Index of the action to take among actions Q-values q, considering only the actions
+    // whose bit is set in mask (which must not be 0). visits holds the visit count of each
+    // action of the cell and is only used, and updated, by UCB. Allocates nothing.
+    template <class Value>
+    int choose(const Value* q, int actions, unsigned mask, double parameter, std::uint32_t* visits,
+               RandomGenerator& rng) const {
+        if (strategy == EPSILON_GREEDY) {
+            if (rng.nextDouble() < parameter) {
+                // Explore: the n-th allowed action, for a random n
+                int n = static_cast<int>(rng.nextBelow(static_cast<std::uint32_t>(countActions(mask, actions))));
+                int action = 0;
+                for (; !(mask >> action & 1) || n-- > 0; ++action) {
+                }
+                return action;
+            }
+            return bestAction(q, actions, mask);
+        }
+        if (parameter <= 0.0) {
+            return bestAction(q, actions, mask);
+        }
+
+        if (strategy == SOFTMAX) {
+            // Weights relative to the best value, so exp cannot overflow.
+            double best = static_cast<double>(q[bestAction(q, actions, mask)]);
+            double weights[MAX_POLICY_ACTIONS];
+            double total = 0.0;
+            for (int action = 0; action < actions; ++action) {
+                weights[action] = (mask >> action & 1) ? std::exp((static_cast<double>(q[action]) - best) / parameter) : 0.0;
+                total += weights[action];
+            }
+            double draw = rng.nextDouble() * total;
+            int chosen = bestAction(q, actions, mask); // Kept if rounding leaves draw past the last weight
+            for (int action = 0; action < actions; ++action) {
+                if ((mask >> action & 1) && (draw -= weights[action]) < 0.0) {
+                    chosen = action;
+                    break;
+                }
+            }
+            return chosen;
+        }
+
+        // UCB: try every allowed action once, then balance value against how rarely it was taken.
+        std::uint32_t cellVisits = 0;
+        int chosen = -1;
+        for (int action = 0; action < actions; ++action) {
+            if (mask >> action & 1) {
+                if (visits[action] == 0) {
+                    chosen = action;
+                    break;
+                }
+                cellVisits += visits[action];
+            }
+        }
+        if (chosen < 0) {
+            double logVisits = std::log(static_cast<double>(cellVisits));
+            double bestScore = 0.0;
+            for (int action = 0; action < actions; ++action) {
+                if (mask >> action & 1) {
+                    double score = static_cast<double>(q[action]) + parameter * std::sqrt(logVisits / visits[action]);
+                    if (chosen < 0 || score > bestScore) {
+                        chosen = action;
+                        bestScore = score;
+                    }
+                }
+            }
+        }
+        visits[chosen]++;
+        return chosen;
+    }
+
+    // Index of the allowed action with the highest Q-value, the first one on ties.
+    template <class Value>
+    static int bestAction(const Value* q, int actions, unsigned mask) {
+        int best = -1;
+        for (int action = 0; action < actions; ++action) {
+            if ((mask >> action & 1) && (best < 0 || q[action] > q[best])) {
+                best = action;
+            }
+        }
+        return best;
+    }
+
+    // Number of allowed actions in a mask.
+    static int countActions(unsigned mask, int actions) {
+        int count = 0;
+        for (int action = 0; action < actions; ++action) {
+            count += mask >> action & 1;
+        }
+        return count;
+    }
+};
+
+// Function to read a strategy name: "epsilon", "softmax" or "ucb". Returns false for other names.
+inline bool parseExplorationStrategy(const std::string& name, ExplorationStrategy& strategy) {
+    if (name == "epsilon") {
+        strategy = EPSILON_GREEDY;
+    } else if (name == "softmax") {
+        strategy = SOFTMAX;
+    } else if (name == "ucb") {
+        strategy = UCB;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Function to read a schedule name: "constant", "linear" or "exponential". Returns false for other names.
+inline bool parseDecaySchedule(const std::string& name, DecaySchedule& decay) {
+    if (name == "constant") {
+        decay = DECAY_CONSTANT;
+    } else if (name == "linear") {
+        decay = DECAY_LINEAR;
+    } else if (name == "exponential") {
+        decay = DECAY_EXPONENTIAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+#endif // EXPLORATIONPOLICY_H
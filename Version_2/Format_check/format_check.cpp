@@ -0,0 +1,204 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "../QTable.cpp"
+#include "../BufferedWriter.cpp"
+#include "../MazeBinary.cpp"
+#include "../MazeGenerator.cpp"
+#include "../MazeUtils.cpp"
+#include "../AgentUtils.cpp"
+#include "../Training.cpp"
+#include "../TrajectoryLog.cpp"
+#include "../QCheckpoint.cpp"
+
+// Checks that the file formats read back what was written: a binary maze (.mzb) and its
+// rejection when a cell code is corrupt, a Q-table checkpoint (.qck) saved and loaded again
+// and its rejection on another maze, and a trajectory log (.mzt) replayed to the state the
+// agent and maze were in when it was written. Prints each failed check and exits with 1 if
+// there were any, so it can run after a build.
+// Usage: format_check [maze file]
+// The maze defaults to ../maze.txt. Temporary files are written to the current directory.
+
+static int failures = 0;
+
+// Function to report a failed check.
+static void check(bool passed, const std::string& what) {
+    if (!passed) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Write the maze as a binary file and read it back, then corrupt one cell code and check the
+// file is rejected rather than loaded with a code outside the cell table.
+static void checkMazeBinary(MazeGrid& maze) {
+    const std::string fileName = "format_check.mzb";
+
+    maze.restoreItems();
+    check(writeMazeBinary(fileName, maze), "writing the binary maze");
+    MazeGrid loaded = readMazeBinary(fileName);
+    check(loaded.rows == maze.rows && loaded.cols == maze.cols && loaded.hash() == maze.hash(),
+          "binary maze read back");
+
+    std::FILE* file = std::fopen(fileName.c_str(), "r+b");
+    std::fseek(file, static_cast<long>(sizeof(MazeFileHeader)) + maze.cols + 1, SEEK_SET);
+    std::fputc(200, file);
+    std::fclose(file);
+    check(readMazeBinary(fileName).empty(), "rejecting an unknown cell code in a binary maze");
+
+    std::remove(fileName.c_str());
+}
+
+// Save a trained-looking agent, load it into a fresh one and compare, then load it on mazes
+// it was not made on.
+static void checkQCheckpoint(MazeGrid& maze) {
+    const std::string fileName = "format_check.qck";
+
+    Agent saved = initializeAgent(maze, 1);
+    for (int i = 0; i < maze.rows; ++i) {
+        for (int j = 0; j < maze.cols; ++j) {
+            for (int action = 0; action < saved.qTable.getActions(); ++action) {
+                saved.qTable.at(i, j, action) = i * 1000.0 + j + action * 0.125 - 0.5;
+            }
+        }
+    }
+    saved.learningRate = 0.25;
+    saved.discountFactor = 0.75;
+    saved.policy.strategy = UCB;
+    saved.policy.decay = DECAY_LINEAR;
+    saved.policy.start = 0.3;
+    saved.policy.minimum = 0.05;
+    saved.policy.decayEpisodes = 77;
+    saved.episodesTrained = 12;
+    check(saveAgentCheckpoint(fileName, saved, maze), "saving the checkpoint");
+
+    Agent loaded = initializeAgent(maze, 2);
+    check(loadAgentCheckpoint(fileName, loaded, maze), "loading the checkpoint");
+    bool sameValues = loaded.qTable.size() == saved.qTable.size();
+    for (std::size_t i = 0; sameValues && i < saved.qTable.size(); ++i) {
+        sameValues = loaded.qTable.data()[i] == saved.qTable.data()[i];
+    }
+    check(sameValues, "Q-values read back");
+    check(loaded.learningRate == saved.learningRate && loaded.discountFactor == saved.discountFactor,
+          "learning rate and discount factor read back");
+    check(loaded.policy.strategy == saved.policy.strategy && loaded.policy.decay == saved.policy.decay &&
+              loaded.policy.start == saved.policy.start && loaded.policy.minimum == saved.policy.minimum &&
+              loaded.policy.decayEpisodes == saved.policy.decayEpisodes,
+          "exploration policy read back");
+    check(loaded.episodesTrained == saved.episodesTrained, "trained episodes read back");
+
+    // Same size, one cell different: the hash must not match.
+    MazeGrid changed = maze;
+    changed[0][0] = changed[0][0] == WALL ? EMPTY : WALL;
+    Agent other = initializeAgent(maze, 3);
+    check(!loadAgentCheckpoint(fileName, other, changed), "rejecting a maze with another hash");
+
+    MazeGeneratorOptions options;
+    options.rows = maze.rows + 2;
+    options.cols = maze.cols;
+    MazeGrid larger = generateMaze(options);
+    larger.buildMoves();
+    Agent largerAgent = initializeAgent(larger, 4);
+    check(!loadAgentCheckpoint(fileName, largerAgent, larger), "rejecting a maze with other dimensions");
+
+    // A file cut short must not be mapped.
+    std::FILE* file = std::fopen(fileName.c_str(), "r+b");
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fclose(file);
+    std::vector<char> bytes(static_cast<std::size_t>(size) / 2);
+    file = std::fopen(fileName.c_str(), "rb");
+    std::size_t read = std::fread(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+    file = std::fopen(fileName.c_str(), "wb");
+    std::fwrite(bytes.data(), 1, read, file);
+    std::fclose(file);
+    Agent truncated = initializeAgent(maze, 5);
+    check(!loadAgentCheckpoint(fileName, truncated, maze), "rejecting a truncated checkpoint");
+
+    std::remove(fileName.c_str());
+}
+
+// State of the agent and maze at the end of an episode, as training left them.
+struct EpisodeEnd {
+    int steps;
+    Position position;
+    Direction direction;
+    int stepSize;
+    int perceptField;
+    std::vector<std::uint8_t> cells;
+};
+
+// Log a few episodes, then replay the last step of each and compare with the live state.
+static void checkTrajectory(MazeGrid& maze) {
+    const std::string fileName = "format_check.mzt";
+    const int episodes = 3;
+
+    Agent agent = initializeAgent(maze, 6);
+    TrajectoryWriter writer(64); // Small buffers, so the records are handed off many times
+    maze.restoreItems();
+    check(writer.open(fileName, maze), "opening the trajectory");
+
+    std::vector<EpisodeEnd> ends;
+    long long totalSteps = 0;
+    for (int episode = 1; episode <= episodes; ++episode) {
+        maze.restoreItems();
+        resetAgent(agent, maze);
+        writer.beginEpisode(episode);
+        EpisodeResult result = runEpisode(agent, maze, 5000, nullptr, &writer);
+        ends.push_back({result.steps, agent.position, agent.direction, agent.stepSize, agent.perceptField, maze.cells});
+        totalSteps += result.steps;
+    }
+    check(writer.close(), "closing the trajectory");
+
+    TrajectoryReader reader;
+    check(reader.open(fileName), "reading the trajectory");
+    check(reader.header().rows == static_cast<std::uint32_t>(maze.rows) &&
+              reader.header().cols == static_cast<std::uint32_t>(maze.cols),
+          "trajectory dimensions");
+    maze.restoreItems();
+    check(reader.header().mazeHash == maze.hash(), "trajectory maze hash");
+    check(reader.size() == static_cast<std::uint64_t>(totalSteps), "one record per step");
+
+    for (int episode = 1; episode <= episodes; ++episode) {
+        const EpisodeEnd& end = ends[episode - 1];
+        std::string name = "episode " + std::to_string(episode);
+        Agent replayed = initializeAgent(maze, 7);
+        TrajectoryRecord record;
+        if (!replayTrajectory(reader, maze, episode, end.steps - 1, replayed, record)) {
+            check(false, "replaying the last step of " + name);
+            continue;
+        }
+        check(replayed.position.x == end.position.x && replayed.position.y == end.position.y, name + " position");
+        check(replayed.direction == end.direction && replayed.stepSize == end.stepSize &&
+                  replayed.perceptField == end.perceptField,
+              name + " direction, stepSize and perceptField");
+        check(maze.cells == end.cells, name + " items taken");
+        check(!replayTrajectory(reader, maze, episode, end.steps, replayed, record), name + " ends at its last step");
+    }
+    maze.restoreItems();
+
+    std::remove(fileName.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    std::string fileName = (argc > 1) ? argv[1] : "../maze.txt";
+    auto maze = readMaze(fileName);
+    if (maze.empty()) {
+        std::cerr << "Error: Failed to load maze " << fileName << std::endl;
+        return 1;
+    }
+
+    checkMazeBinary(maze);
+    checkQCheckpoint(maze);
+    checkTrajectory(maze);
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All format checks passed." << std::endl;
+    return 0;
+}
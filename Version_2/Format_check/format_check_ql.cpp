@@ -0,0 +1,116 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "../../Maze.h"
+#include "../../QLearningAgent.h"
+#include "../MazeGrid.h"
+#include "../MazeGenerator.h"
+
+// Checks the Q-table checkpoint (.qck) of the root QLearningAgent: saved after some training,
+// loaded into a fresh agent and compared, then rejected on mazes it was not made on. A
+// separate program from format_check, since the root Agent and Version_2's cannot share one.
+// Build together with ../../Maze.cpp, ../../QLearningAgent.cpp, ../../QPlanner.cpp,
+// ../MazeBinary.cpp, ../MazeGenerator.cpp, ../BufferedWriter.cpp and ../QCheckpoint.cpp.
+// Usage: format_check_ql [maze file]
+// The maze defaults to ../../maze_testrun_1_newlines.txt. Temporary files are written to the
+// current directory.
+
+static int failures = 0;
+
+// Function to report a failed check.
+static void check(bool passed, const std::string& what) {
+    if (!passed) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Function to copy the maze as the root loader sees it into a grid, with extraRows empty rows below.
+static MazeGrid copyMaze(const Maze& maze, int extraRows) {
+    MazeGrid grid;
+    grid.resize(maze.getSize().first + extraRows, maze.getSize().second);
+    for (int row = 0; row < maze.getSize().first; ++row) {
+        for (int col = 0; col < grid.cols; ++col) {
+            grid[row][col] = maze.at(row, col);
+        }
+    }
+    return grid;
+}
+
+// Function to load a checkpoint into a fresh agent on the maze written from grid.
+static bool loadOnMaze(const std::string& checkpointFile, const MazeGrid& grid) {
+    const std::string mazeFile = "format_check_ql.txt";
+    if (!writeMazeText(mazeFile, grid)) {
+        check(false, "writing " + mazeFile);
+        return false;
+    }
+    Maze maze(mazeFile);
+    std::remove(mazeFile.c_str());
+    std::pair<int, int> start = maze.findNumberCoordinates(START);
+    QLearningAgent agent(maze, start.first, start.second, 3);
+    return agent.loadCheckpoint(checkpointFile, maze);
+}
+
+// Train an agent for a few episodes, save it, load it into a fresh one and compare, then load
+// it on mazes it was not made on.
+static void checkQCheckpoint(const Maze& maze) {
+    const std::string fileName = "format_check_ql.qck";
+    std::pair<int, int> start = maze.findNumberCoordinates(START);
+
+    QLearningAgent saved(maze, start.first, start.second, 1);
+    ExplorationPolicy policy;
+    policy.strategy = UCB;
+    policy.decay = DECAY_LINEAR;
+    policy.start = 0.3;
+    policy.minimum = 0.05;
+    policy.decayEpisodes = 77;
+    saved.setExplorationPolicy(policy);
+    for (int episode = 0; episode < 12; ++episode) {
+        for (int step = 0; step < 50; ++step) {
+            saved.move(maze);
+        }
+        saved.reset();
+    }
+    check(saved.saveCheckpoint(fileName, maze), "saving the checkpoint");
+
+    QLearningAgent loaded(maze, start.first, start.second, 2);
+    check(loaded.loadCheckpoint(fileName, maze), "loading the checkpoint");
+    check(loaded.getQValues() == saved.getQValues(), "Q-values read back");
+    const ExplorationPolicy& loadedPolicy = loaded.explorationPolicy();
+    check(loadedPolicy.strategy == policy.strategy && loadedPolicy.decay == policy.decay &&
+              loadedPolicy.start == policy.start && loadedPolicy.minimum == policy.minimum &&
+              loadedPolicy.decayEpisodes == policy.decayEpisodes,
+          "exploration policy read back");
+    check(loaded.episodesStarted() == saved.episodesStarted(), "episodes read back");
+    check(loaded.explorationParameter() == saved.explorationParameter(), "exploration parameter at the episodes run");
+
+    // Same size, one cell different: the hash must not match.
+    MazeGrid changed = copyMaze(maze, 0);
+    int lastRow = changed.rows - 1;
+    int lastCol = changed.cols - 1;
+    changed[lastRow][lastCol] = changed[lastRow][lastCol] == WALL ? EMPTY : WALL;
+    check(!loadOnMaze(fileName, changed), "rejecting a maze with another hash");
+    check(!loadOnMaze(fileName, copyMaze(maze, 2)), "rejecting a maze with other dimensions");
+
+    std::remove(fileName.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    std::string fileName = (argc > 1) ? argv[1] : "../../maze_testrun_1_newlines.txt";
+    Maze maze(fileName);
+    if (maze.getSize().first == 0) {
+        std::cerr << "Error: Failed to load maze " << fileName << std::endl;
+        return 1;
+    }
+
+    checkQCheckpoint(maze);
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All root checkpoint checks passed." << std::endl;
+    return 0;
+}
@@ -3,11 +3,11 @@
     #include <vector>
     #include <string>
 
-    // Constants for maze elements
-    enum MazeElements {
-        EMPTY = 0, WALL = 1, START = 2, GOAL = 3,
-        GOGGLES = 4, SPEED_POTION = 5, FOG = 6, SLOWPOKE_POTION = 7
-    };
+    #include "../Random.h"
+    #include "../TerminalRenderer.h"
+
+    // Cell codes and their effects, shared with the rest of the project
+    #include "../MazeElements.h"
 
     // Directions
     enum Direction { NORTH, EAST, SOUTH, WEST };
@@ -25,6 +25,7 @@
         std::vector<std::string> moveHistory;
         std::vector<int> actionList; // New: List of possible actions
         int lastAction; // New: Last action taken
+        RandomGenerator rng; // Random number generator for action selection
     };
 
 
@@ -55,26 +56,26 @@
         return maze;
     }
 
-    // Function to print the maze
-    void printMaze(const std::vector<std::vector<int>>& maze, const Agent& agent) {
-        char agentSymbol;
+    // Symbol of the agent facing its direction
+    char agentSymbol(const Agent& agent) {
         switch (agent.direction) {
-            case NORTH: agentSymbol = '^'; break;
-            case EAST:  agentSymbol = '>'; break;
-            case SOUTH: agentSymbol = 'V'; break;
-            case WEST:  agentSymbol = '<'; break;
+            case NORTH: return '^';
+            case EAST:  return '>';
+            case SOUTH: return 'V';
+            case WEST:  return '<';
         }
+        return 'X';
+    }
 
-        for (int i = 0; i < maze.size(); ++i) {
-            for (int j = 0; j < maze[i].size(); ++j) {
-                if (agent.position.x == i && agent.position.y == j) {
-                    std::cout << agentSymbol << " ";  // Display agent with direction
-                } else {
-                    std::cout << maze[i][j] << " ";
-                }
+    // Function to draw the maze into the next frame of the live view; only changed cells reach the terminal
+    void drawMaze(const std::vector<std::vector<int>>& maze, const Agent& agent, TerminalRenderer& screen) {
+        screen.follow(agent.position.x, agent.position.y);
+        for (int i = screen.top(); i < static_cast<int>(maze.size()) && i < screen.top() + screen.height(); ++i) {
+            for (int j = screen.left(); j < static_cast<int>(maze[i].size()) && j < screen.left() + screen.width(); ++j) {
+                screen.set(i, j, static_cast<char>('0' + maze[i][j]));
             }
-            std::cout << std::endl;
         }
+        screen.set(agent.position.x, agent.position.y, agentSymbol(agent));
     }
 
     // Function to initialize the agent
@@ -134,23 +135,11 @@
     // Function to update agent state based on current position
     void updateAgentState(Agent& agent, std::vector<std::vector<int>>& maze) {
         int& cell = maze[agent.position.x][agent.position.y];
-        switch (cell) {
-            case GOGGLES: 
-                agent.perceptField = std::min(agent.perceptField + 1, 3);
-                cell = EMPTY; // Remove goggles from maze
-                break;
-            case SPEED_POTION: 
-                agent.stepSize = std::min(agent.stepSize + 1, 3);
-                cell = EMPTY; // Remove speed potion
-                break;
-            case FOG: 
-                agent.perceptField = std::max(agent.perceptField - 1, 1);
-                cell = EMPTY; // Remove fog
-                break;
-            case SLOWPOKE_POTION: 
-                agent.stepSize = std::max(agent.stepSize - 1, 1);
-                cell = EMPTY; // Remove slowpoke potion
-                break;
+        // Apply the item effect from the cell table and remove the item if it is used up.
+        agent.stepSize = stepSizeAfter(agent.stepSize, cell);
+        agent.perceptField = perceptFieldAfter(agent.perceptField, cell);
+        if (isConsumable(cell)) {
+            cell = EMPTY;
         }
     }
 
@@ -165,12 +154,12 @@
         if (agent.position.x == agent.previousPosition.x && agent.position.y == agent.previousPosition.y) {
             // If the agent hasn't moved, choose a different action
             if (agent.lastAction == 1) { // If last action was forward, try turning
-                return (rand() % 2) + 2; // Randomly choose between turning left or right
+                return agent.rng.nextBelow(2) + 2; // Randomly choose between turning left or right
             } else { // If last action was turning, try forward or turn again
-                return (rand() % 2) ? agent.lastAction : 1; // Randomly choose forward or the same turn
+                return agent.rng.nextBelow(2) ? agent.lastAction : 1; // Randomly choose forward or the same turn
             }
         }
-        return agent.actionList[rand() % agent.actionList.size()]; // Randomly choose any action
+        return agent.actionList[agent.rng.nextBelow(agent.actionList.size())]; // Randomly choose any action
     }
 
 
@@ -255,13 +244,15 @@
         Agent agent = initializeAgent(maze);
         int steps = 0;
 
-        printMaze(maze, agent);
-
-        while (true) {
-            int command;
-            std::cout << "Enter command (2=Forward, 1=Left, 3=Right): ";
-            std::cin >> command;
+        // The maze is drawn in place, so each move rewrites only the cells that changed
+        const char* prompt = "Enter command (2=Forward, 1=Left, 3=Right): ";
+        TerminalRenderer screen(maze.size(), maze.empty() ? 0 : maze[0].size());
+        drawMaze(maze, agent, screen);
+        screen.setStatus(prompt);
+        screen.present();
 
+        int command;
+        while (std::cin >> command) {
             if (command == 2) {
                 if (moveAgent(agent, maze)) {
                     updateAgentState(agent, maze);
@@ -270,17 +261,21 @@
             } else if (command == 1 || command == 3) {
                 turnAgent(agent, command);
             } else {
-                std::cout << "Invalid command!" << std::endl;
+                screen.setStatus(std::string("Invalid command! ") + prompt);
+                screen.present();
                 continue;
             }
 
-            printMaze(maze, agent);
-            std::cout << "-------------------------------------" << std::endl;
+            drawMaze(maze, agent, screen);
             if (maze[agent.position.x][agent.position.y] == GOAL) {
-                std::cout << "Goal reached in " << steps << " steps!" << std::endl;
+                screen.setStatus("Goal reached in " + std::to_string(steps) + " steps!");
+                screen.present();
                 break;
             }
+            screen.setStatus(prompt);
+            screen.present();
         }
+        screen.release();
 
         return 0;
     }
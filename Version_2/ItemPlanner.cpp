@@ -0,0 +1,162 @@
+#include "ItemPlanner.h"
+
+#include <iostream>
+#include <algorithm>
+
+static const std::uint32_t NO_NODE = 0xFFFFFFFF;
+
+// Search node: the state, the potions consumed so far and how it was reached.
+struct PlannerNode {
+    std::uint32_t state; // (cell buffer index << 4) | (direction << 2) | (stepSize - 1)
+    std::uint32_t parent; // Node this one was reached from, NO_NODE for the start
+    std::uint64_t consumed; // Bit i set once potion i has been taken
+    std::uint8_t action; // Action taken from the parent
+};
+
+// Open-addressing hash set of node indices, keyed on (state, consumed).
+class VisitedSet {
+public:
+    explicit VisitedSet(const std::vector<PlannerNode>& nodes) : nodes(nodes), count(0) {
+        slots.assign(1 << 16, NO_NODE);
+    }
+
+    // Insert the node unless an equal state is already present. Returns false if it was.
+    bool insert(std::uint32_t node) {
+        if ((count + 1) * 2 > slots.size()) {
+            grow();
+        }
+        const PlannerNode& added = nodes[node];
+        std::size_t mask = slots.size() - 1;
+        for (std::size_t slot = hash(added) & mask;; slot = (slot + 1) & mask) {
+            if (slots[slot] == NO_NODE) {
+                slots[slot] = node;
+                count++;
+                return true;
+            }
+            const PlannerNode& present = nodes[slots[slot]];
+            if (present.state == added.state && present.consumed == added.consumed) {
+                return false;
+            }
+        }
+    }
+
+private:
+    static std::size_t hash(const PlannerNode& node) {
+        std::uint64_t h = node.consumed * 0x9E3779B97F4A7C15ULL ^ node.state;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+    void grow() {
+        std::vector<std::uint32_t> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, NO_NODE);
+        std::size_t mask = slots.size() - 1;
+        for (std::uint32_t node : old) {
+            if (node == NO_NODE) {
+                continue;
+            }
+            std::size_t slot = hash(nodes[node]) & mask;
+            while (slots[slot] != NO_NODE) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = node;
+        }
+    }
+
+    const std::vector<PlannerNode>& nodes;
+    std::vector<std::uint32_t> slots;
+    std::size_t count;
+};
+
+ItemRoute planItemRoute(const MazeGrid& maze) {
+    ItemRoute route = {false, -1, {}, 0, 0};
+
+    // Number the potions and find START.
+    std::vector<std::int8_t> potionBit(maze.cells.size(), -1);
+    int potions = 0;
+    std::size_t startCell = 0;
+    bool hasStart = false;
+    for (int i = 0; i < maze.rows; ++i) {
+        for (int j = 0; j < maze.cols; ++j) {
+            int cell = maze[i][j];
+            if (isConsumable(cell) && CELL_TYPES[cell].stepSizeChange != 0) {
+                if (potions == MAX_PLANNER_ITEMS) {
+                    std::cerr << "Error: More than " << MAX_PLANNER_ITEMS << " potions in the maze." << std::endl;
+                    return route;
+                }
+                potionBit[maze.index(i, j)] = potions++;
+            } else if (cell == START && !hasStart) {
+                startCell = maze.index(i, j);
+                hasStart = true;
+            }
+        }
+    }
+    if (!hasStart) {
+        return route;
+    }
+
+    // Nodes are stored in the order they are reached, so the vector doubles as the BFS queue.
+    std::vector<PlannerNode> nodes;
+    VisitedSet visited(nodes);
+    nodes.push_back({static_cast<std::uint32_t>(startCell << 4) | (EAST << 2), NO_NODE, 0, 0});
+    visited.insert(0);
+
+    std::uint32_t goal = NO_NODE;
+    if (maze.cells[startCell] == GOAL) {
+        goal = 0;
+    }
+
+    for (std::size_t head = 0; head < nodes.size() && goal == NO_NODE; ++head) {
+        PlannerNode current = nodes[head];
+        route.statesExpanded++;
+
+        int stepSize = (current.state & 0x03) + 1;
+        int direction = (current.state >> 2) & 0x03;
+        std::size_t cell = current.state >> 4;
+
+        for (int action = 1; action <= 3; ++action) {
+            // Turn and move as turnAgent and moveAgent do.
+            int newDirection = (direction + action + 2) & 0x03;
+            std::size_t newCell = maze.landing(cell, newDirection, stepSize);
+
+            // Take a potion that is still there, as updateAgentState does.
+            int newStepSize = stepSize;
+            std::uint64_t consumed = current.consumed;
+            int bit = potionBit[newCell];
+            if (bit >= 0 && !(consumed >> bit & 1)) {
+                consumed |= std::uint64_t(1) << bit;
+                newStepSize = stepSizeAfter(stepSize, maze.cells[newCell]);
+            }
+
+            std::uint32_t state = static_cast<std::uint32_t>(newCell << 4) | (newDirection << 2) | (newStepSize - 1);
+            nodes.push_back({state, static_cast<std::uint32_t>(head), consumed, static_cast<std::uint8_t>(action)});
+            if (!visited.insert(nodes.size() - 1)) {
+                nodes.pop_back();
+                continue;
+            }
+            if (maze.cells[newCell] == GOAL) {
+                goal = nodes.size() - 1;
+                break;
+            }
+        }
+    }
+
+    if (goal == NO_NODE) {
+        return route;
+    }
+
+    // Follow the parents back to the start.
+    for (std::uint32_t node = goal; nodes[node].parent != NO_NODE; node = nodes[node].parent) {
+        route.actions.push_back(nodes[node].action);
+    }
+    std::reverse(route.actions.begin(), route.actions.end());
+
+    route.solved = true;
+    route.length = route.actions.size();
+    for (std::uint64_t consumed = nodes[goal].consumed; consumed; consumed &= consumed - 1) {
+        route.potionsTaken++;
+    }
+    return route;
+}
@@ -0,0 +1,29 @@
+#ifndef ITEMPLANNER_H
+#define ITEMPLANNER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "MazeGrid.h"
+
+// Largest number of potions the item-aware planner can track.
+const int MAX_PLANNER_ITEMS = 64;
+
+// Shortest route found by the item-aware planner.
+struct ItemRoute {
+    bool solved; // Whether the GOAL cell can be reached from START
+    int length; // Number of actions on the shortest route, -1 if unsolved
+    std::vector<int> actions; // Actions in order: 1 - Turn Left, 2 - Forward, 3 - Turn Right, each then forward
+    int potionsTaken; // Potions picked up along the route
+    long long statesExpanded; // Number of search states taken off the queue
+};
+
+// Function to find the minimum-step route from START to GOAL with breadth-first search over
+// (position, direction, stepSize, potions consumed). Unlike solveMaze, items are taken when
+// entered, as updateAgentState does, so routes that depend on picking up (or avoiding) potions
+// are found exactly. Goggles and fog only change perceptField, which never affects a move, so
+// states that differ only in those are merged. Returns an unsolved route if the maze holds
+// more than MAX_PLANNER_ITEMS potions.
+ItemRoute planItemRoute(const MazeGrid& maze);
+
+#endif // ITEMPLANNER_H
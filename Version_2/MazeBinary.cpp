@@ -0,0 +1,158 @@
+#include "MazeBinary.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedMazeFile::MappedMazeFile() : data(nullptr), size(0) {}
+
+MappedMazeFile::~MappedMazeFile() {
+    close();
+}
+
+bool MappedMazeFile::open(const std::string& fileName) {
+    close();
+
+#ifdef _WIN32
+    // No mmap here, so read the whole file in one go instead.
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << fileName << std::endl;
+        return false;
+    }
+    buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+    data = buffer.data();
+    size = buffer.size();
+#else
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open file: " << fileName << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        std::cerr << "Failed to read file: " << fileName << std::endl;
+        return false;
+    }
+    void* mapping = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping stays valid after the descriptor is closed.
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map file: " << fileName << std::endl;
+        return false;
+    }
+    data = static_cast<const std::uint8_t*>(mapping);
+    size = static_cast<std::size_t>(info.st_size);
+#endif
+
+    // Validate the header and that the file holds every cell it promises.
+    if (size < sizeof(MazeFileHeader) ||
+        std::memcmp(header().magic, MAZE_FILE_MAGIC, sizeof(MAZE_FILE_MAGIC)) != 0 ||
+        header().version != MAZE_FILE_VERSION ||
+        size - sizeof(MazeFileHeader) < static_cast<std::size_t>(header().rows) * header().cols) {
+        std::cerr << "Error: " << fileName << " is not a valid binary maze file." << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedMazeFile::close() {
+    if (data == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    buffer.clear();
+#else
+    munmap(const_cast<std::uint8_t*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+bool isMazeBinaryFile(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    char magic[sizeof(MAZE_FILE_MAGIC)];
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAZE_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+bool writeMazeBinary(const std::string& fileName, const MazeGrid& maze) {
+    MazeFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAZE_FILE_MAGIC, sizeof(MAZE_FILE_MAGIC));
+    header.version = MAZE_FILE_VERSION;
+    header.rows = maze.rows;
+    header.cols = maze.cols;
+    header.startRow = header.startCol = -1;
+    header.goalRow = header.goalCol = -1;
+
+    // Collect the header statistics first, so the cells can be written straight from the grid.
+    for (int i = 0; i < maze.rows; ++i) {
+        for (int j = 0; j < maze.cols; ++j) {
+            int cell = maze[i][j];
+            if (cell < 0 || cell >= MAZE_ELEMENT_COUNT) {
+                std::cerr << "Error: Unknown cell code " << cell << " at (" << i << ", " << j << ")." << std::endl;
+                return false;
+            }
+            header.itemCounts[cell]++;
+            if (cell == START) {
+                header.startRow = i;
+                header.startCol = j;
+            } else if (cell == GOAL) {
+                header.goalRow = i;
+                header.goalCol = j;
+            }
+        }
+    }
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << fileName << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (int i = 0; i < maze.rows; ++i) {
+        file.write(reinterpret_cast<const char*>(maze[i]), maze.cols);
+    }
+    return static_cast<bool>(file);
+}
+
+bool checkMazeFileCells(const MappedMazeFile& file, const std::string& fileName) {
+    const MazeFileHeader& header = file.header();
+    const std::uint8_t* cells = file.cells();
+    std::size_t count = static_cast<std::size_t>(header.rows) * header.cols;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (cells[i] >= MAZE_ELEMENT_COUNT) {
+            std::cerr << "Error: Unknown cell code " << static_cast<int>(cells[i]) << " at (" << i / header.cols << ", "
+                      << i % header.cols << ") of " << fileName << "." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+MazeGrid readMazeBinary(const std::string& fileName) {
+    MazeGrid maze;
+    MappedMazeFile file;
+    if (!file.open(fileName) || !checkMazeFileCells(file, fileName)) {
+        return maze;
+    }
+
+    const MazeFileHeader& header = file.header();
+    maze.resize(header.rows, header.cols);
+    for (std::uint32_t i = 0; i < header.rows; ++i) {
+        const std::uint8_t* row = file.cells() + static_cast<std::size_t>(i) * header.cols;
+        std::memcpy(maze[i], row, header.cols);
+    }
+    maze.buildMoves();
+    return maze;
+}
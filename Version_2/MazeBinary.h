@@ -0,0 +1,71 @@
+#ifndef MAZEBINARY_H
+#define MAZEBINARY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "MazeGrid.h"
+
+// Binary maze file (.mzb) layout:
+//   MazeFileHeader, followed by rows * cols bytes, one cell code per byte, row-major.
+// Fields are stored in native (little-endian) byte order.
+const char MAZE_FILE_MAGIC[4] = {'M', 'A', 'Z', 'B'};
+const std::uint32_t MAZE_FILE_VERSION = 1;
+
+struct MazeFileHeader {
+    char magic[4];              // Always MAZE_FILE_MAGIC
+    std::uint32_t version;      // Format version, MAZE_FILE_VERSION
+    std::uint32_t rows;         // Number of rows in the maze
+    std::uint32_t cols;         // Number of columns in the maze
+    std::int32_t startRow;      // Row of the START cell, -1 if none
+    std::int32_t startCol;      // Column of the START cell, -1 if none
+    std::int32_t goalRow;       // Row of the GOAL cell, -1 if none
+    std::int32_t goalCol;       // Column of the GOAL cell, -1 if none
+    std::uint32_t itemCounts[MAZE_ELEMENT_COUNT]; // Number of cells holding each cell code
+};
+
+// Read-only view of a binary maze file, memory-mapped where the platform allows it.
+class MappedMazeFile {
+public:
+    MappedMazeFile();
+    ~MappedMazeFile();
+    MappedMazeFile(const MappedMazeFile&) = delete;
+    MappedMazeFile& operator=(const MappedMazeFile&) = delete;
+
+    // Map the file and validate its header. Returns false if the file cannot be used.
+    bool open(const std::string& fileName);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    const MazeFileHeader& header() const { return *reinterpret_cast<const MazeFileHeader*>(data); }
+
+    // Pointer to the rows * cols cell codes, row-major.
+    const std::uint8_t* cells() const { return data + sizeof(MazeFileHeader); }
+
+    // Cell code at (row, col). No bounds checking.
+    int at(int row, int col) const { return cells()[static_cast<std::size_t>(row) * header().cols + col]; }
+
+private:
+    const std::uint8_t* data; // Start of the mapped file
+    std::size_t size; // Size of the mapped file in bytes
+#ifdef _WIN32
+    std::vector<std::uint8_t> buffer; // File contents when mmap is not available
+#endif
+};
+
+// Function to check that every cell of an open maze file holds a known cell code (below
+// MAZE_ELEMENT_COUNT). Reports the first unknown code and returns false if there is one.
+bool checkMazeFileCells(const MappedMazeFile& file, const std::string& fileName);
+
+// Function to check whether a file starts with the binary maze magic.
+bool isMazeBinaryFile(const std::string& fileName);
+
+// Function to write a maze to a binary maze file. Returns false on failure.
+bool writeMazeBinary(const std::string& fileName, const MazeGrid& maze);
+
+// Function to read a binary maze file into a maze grid.
+MazeGrid readMazeBinary(const std::string& fileName);
+
+#endif // MAZEBINARY_H
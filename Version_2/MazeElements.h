@@ -0,0 +1,62 @@
+#ifndef MAZEELEMENTS_H
+#define MAZEELEMENTS_H
+
+// Cell codes used in the maze files.
+enum MazeElements {
+    EMPTY = 0, WALL = 1, START = 2, GOAL = 3,
+    GOGGLES = 4, SPEED_POTION = 5, FOG = 6, SLOWPOKE_POTION = 7
+};
+
+// Number of distinct cell codes.
+const int MAZE_ELEMENT_COUNT = 8;
+
+// Largest stepSize and perceptField an agent can reach through items.
+const int MAX_STEP_SIZE = 3;
+const int MAX_PERCEPT_FIELD = 3;
+
+// What a cell code means to an agent.
+struct CellType {
+    bool passable; // Whether an agent can stand on the cell
+    int reward; // Reward for entering the cell
+    int stepSizeChange; // Change of stepSize when entering the cell, kept within 1..MAX_STEP_SIZE
+    int perceptFieldChange; // Change of perceptField when entering the cell, kept within 1..MAX_PERCEPT_FIELD
+    bool consumed; // Whether the item is removed from the maze once entered
+};
+
+// The single table every agent and tool reads cell behaviour from, indexed by cell code.
+constexpr CellType CELL_TYPES[MAZE_ELEMENT_COUNT] = {
+    {true, -1, 0, 0, false},    // EMPTY
+    {false, -10, 0, 0, false},  // WALL
+    {true, -1, 0, 0, false},    // START
+    {true, 100, 0, 0, false},   // GOAL
+    {true, 5, 0, 1, true},      // GOGGLES
+    {true, 5, 1, 0, true},      // SPEED_POTION
+    {true, -5, 0, -1, true},    // FOG
+    {true, -5, -1, 0, true},    // SLOWPOKE_POTION
+};
+
+static_assert(!CELL_TYPES[WALL].passable, "Walls must block movement");
+static_assert(CELL_TYPES[GOAL].reward > 0, "Reaching the goal must be rewarded");
+
+// Table lookups. Cell codes must be below MAZE_ELEMENT_COUNT.
+constexpr bool isPassable(int code) { return CELL_TYPES[code].passable; }
+constexpr int cellReward(int code) { return CELL_TYPES[code].reward; }
+constexpr bool isConsumable(int code) { return CELL_TYPES[code].consumed; }
+
+// stepSize and perceptField after entering a cell.
+constexpr int stepSizeAfter(int stepSize, int code) {
+    return stepSize + CELL_TYPES[code].stepSizeChange < 1 ? 1
+         : stepSize + CELL_TYPES[code].stepSizeChange > MAX_STEP_SIZE ? MAX_STEP_SIZE
+         : stepSize + CELL_TYPES[code].stepSizeChange;
+}
+constexpr int perceptFieldAfter(int perceptField, int code) {
+    return perceptField + CELL_TYPES[code].perceptFieldChange < 1 ? 1
+         : perceptField + CELL_TYPES[code].perceptFieldChange > MAX_PERCEPT_FIELD ? MAX_PERCEPT_FIELD
+         : perceptField + CELL_TYPES[code].perceptFieldChange;
+}
+
+static_assert(stepSizeAfter(1, SPEED_POTION) == 2 && stepSizeAfter(MAX_STEP_SIZE, SPEED_POTION) == MAX_STEP_SIZE,
+              "Speed potions raise stepSize up to the maximum");
+static_assert(stepSizeAfter(1, SLOWPOKE_POTION) == 1, "Slowpoke potions never drop stepSize below 1");
+
+#endif // MAZEELEMENTS_H
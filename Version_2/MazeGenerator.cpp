@@ -0,0 +1,231 @@
+#include "MazeGenerator.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "BufferedWriter.h"
+#include "Random.h"
+
+// Temporary cell codes used while carving, above the real cell codes.
+// A visited passage cell holds VISITED + the Direction back to the cell it was reached from,
+// so the backtracker needs no stack; the first cell holds VISITED_ROOT.
+static const std::uint8_t VISITED = 16;
+static const std::uint8_t VISITED_ROOT = VISITED + 4;
+static const std::uint8_t FRONTIER = 32;
+
+// Passage cells sit on even rows and columns; neighbouring ones are two cells apart.
+struct CarveCursor {
+    int row;
+    int col;
+};
+
+// Check whether the passage cell two steps away in a direction lies inside the maze.
+static bool hasNeighbour(const MazeGrid& maze, int row, int col, int direction) {
+    return maze.inBounds(row + 2 * DIRECTION_ROW_STEP[direction], col + 2 * DIRECTION_COL_STEP[direction]);
+}
+
+// Recursive backtracker (depth-first search) without an explicit stack.
+static void carveBacktracker(MazeGrid& maze, RandomGenerator& rng) {
+    CarveCursor cursor = {0, 0};
+    maze[0][0] = VISITED_ROOT;
+    for (;;) {
+        std::size_t cell = maze.index(cursor.row, cursor.col);
+
+        // Collect the unvisited neighbours.
+        int candidates[4];
+        int count = 0;
+        for (int direction = 0; direction < 4; ++direction) {
+            if (hasNeighbour(maze, cursor.row, cursor.col, direction) &&
+                maze.cells[cell + 2 * maze.directionOffset(direction)] == WALL) {
+                candidates[count++] = direction;
+            }
+        }
+
+        if (count > 0) {
+            // Carve into a random one and remember the way back.
+            int direction = candidates[rng.nextBelow(count)];
+            std::ptrdiff_t offset = maze.directionOffset(direction);
+            maze.cells[cell + offset] = EMPTY;
+            maze.cells[cell + 2 * offset] = VISITED + ((direction + 2) & 0x03);
+            cursor.row += 2 * DIRECTION_ROW_STEP[direction];
+            cursor.col += 2 * DIRECTION_COL_STEP[direction];
+            continue;
+        }
+
+        // Dead end: finish the cell and step back.
+        std::uint8_t code = maze.cells[cell];
+        maze.cells[cell] = EMPTY;
+        if (code == VISITED_ROOT) {
+            return;
+        }
+        int back = code - VISITED;
+        cursor.row += 2 * DIRECTION_ROW_STEP[back];
+        cursor.col += 2 * DIRECTION_COL_STEP[back];
+    }
+}
+
+// Add the unvisited neighbours of a passage cell to Prim's frontier.
+static void addFrontier(MazeGrid& maze, int row, int col, std::vector<CarveCursor>& frontier) {
+    for (int direction = 0; direction < 4; ++direction) {
+        if (!hasNeighbour(maze, row, col, direction)) {
+            continue;
+        }
+        int newRow = row + 2 * DIRECTION_ROW_STEP[direction];
+        int newCol = col + 2 * DIRECTION_COL_STEP[direction];
+        if (maze[newRow][newCol] == WALL) {
+            maze[newRow][newCol] = FRONTIER;
+            frontier.push_back({newRow, newCol});
+        }
+    }
+}
+
+// Randomized Prim's algorithm: grow the maze from a random frontier cell each step.
+static void carvePrim(MazeGrid& maze, RandomGenerator& rng) {
+    std::vector<CarveCursor> frontier;
+    maze[0][0] = EMPTY;
+    addFrontier(maze, 0, 0, frontier);
+
+    while (!frontier.empty()) {
+        std::size_t pick = rng.nextBelow(static_cast<std::uint32_t>(frontier.size()));
+        CarveCursor cursor = frontier[pick];
+        frontier[pick] = frontier.back();
+        frontier.pop_back();
+
+        // Connect it to a random neighbour that is already part of the maze.
+        std::size_t cell = maze.index(cursor.row, cursor.col);
+        int candidates[4];
+        int count = 0;
+        for (int direction = 0; direction < 4; ++direction) {
+            if (hasNeighbour(maze, cursor.row, cursor.col, direction) &&
+                maze.cells[cell + 2 * maze.directionOffset(direction)] == EMPTY) {
+                candidates[count++] = direction;
+            }
+        }
+        maze.cells[cell + maze.directionOffset(candidates[rng.nextBelow(count)])] = EMPTY;
+        maze.cells[cell] = EMPTY;
+        addFrontier(maze, cursor.row, cursor.col, frontier);
+    }
+}
+
+// Open up dead ends, preferring a wall that also ends a neighbouring dead end.
+static void braidDeadEnds(MazeGrid& maze, RandomGenerator& rng, double braidFactor) {
+    for (int row = 0; row < maze.rows; row += 2) {
+        for (int col = 0; col < maze.cols; col += 2) {
+            std::size_t cell = maze.index(row, col);
+            int walls[4];
+            int wallCount = 0;
+            int openCount = 0;
+            for (int direction = 0; direction < 4; ++direction) {
+                if (!hasNeighbour(maze, row, col, direction)) {
+                    continue;
+                }
+                if (maze.cells[cell + maze.directionOffset(direction)] == WALL) {
+                    walls[wallCount++] = direction;
+                } else {
+                    openCount++;
+                }
+            }
+            if (openCount != 1 || wallCount == 0 || rng.nextDouble() >= braidFactor) {
+                continue;
+            }
+
+            int chosen = walls[rng.nextBelow(wallCount)];
+            for (int i = 0; i < wallCount; ++i) {
+                std::size_t neighbour = cell + 2 * maze.directionOffset(walls[i]);
+                int neighbourOpen = 0;
+                for (int direction = 0; direction < 4; ++direction) {
+                    neighbourOpen += maze.cells[neighbour + maze.directionOffset(direction)] != WALL;
+                }
+                if (neighbourOpen == 1) {
+                    chosen = walls[i];
+                    break;
+                }
+            }
+            maze.cells[cell + maze.directionOffset(chosen)] = EMPTY;
+        }
+    }
+}
+
+bool mazeSizeFits(int rows, int cols) {
+    // GOAL goes on the last even row and column, which is START's corner below 3x3
+    return rows > 0 && cols > 0 && (rows >= 3 || cols >= 3);
+}
+
+MazeGrid generateMaze(const MazeGeneratorOptions& options) {
+    MazeGrid maze;
+    if (!mazeSizeFits(options.rows, options.cols)) {
+        return maze;
+    }
+    maze.resize(options.rows, options.cols);
+    for (int i = 0; i < maze.rows; ++i) {
+        std::uint8_t* row = maze[i];
+        for (int j = 0; j < maze.cols; ++j) {
+            row[j] = WALL;
+        }
+    }
+
+    // Passages and items draw from separate streams, so the item density does not change the layout.
+    RandomGenerator rng(options.seed);
+    RandomGenerator itemRng(options.seed ^ 0x6A09E667F3BCC909ULL);
+
+    if (options.algorithm == PRIM) {
+        carvePrim(maze, rng);
+    } else {
+        carveBacktracker(maze, rng);
+        if (options.algorithm == BRAID) {
+            braidDeadEnds(maze, rng, options.braidFactor);
+        }
+    }
+
+    static const std::uint8_t ITEMS[4] = {GOGGLES, SPEED_POTION, FOG, SLOWPOKE_POTION};
+    if (options.itemDensity > 0) {
+        for (int i = 0; i < maze.rows; ++i) {
+            std::uint8_t* row = maze[i];
+            for (int j = 0; j < maze.cols; ++j) {
+                if (row[j] == EMPTY && itemRng.nextDouble() < options.itemDensity) {
+                    row[j] = ITEMS[itemRng.nextBelow(4)];
+                }
+            }
+        }
+    }
+
+    maze[0][0] = START;
+    maze[(maze.rows - 1) & ~1][(maze.cols - 1) & ~1] = GOAL;
+    return maze;
+}
+
+bool parseMazeAlgorithm(const std::string& name, MazeAlgorithm& algorithm) {
+    if (name == "backtracker") {
+        algorithm = RECURSIVE_BACKTRACKER;
+    } else if (name == "prim") {
+        algorithm = PRIM;
+    } else if (name == "braid") {
+        algorithm = BRAID;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool writeMazeText(const std::string& fileName, const MazeGrid& maze) {
+    std::FILE* file = std::fopen(fileName.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    {
+        BufferedWriter out(file);
+        for (int i = 0; i < maze.rows; ++i) {
+            const std::uint8_t* row = maze[i];
+            out << (i == 0 ? "[[" : "[");
+            for (int j = 0; j < maze.cols; ++j) {
+                out.put(static_cast<char>('0' + row[j]));
+                if (j + 1 < maze.cols) {
+                    out.write(", ", 2);
+                }
+            }
+            out << (i + 1 < maze.rows ? "],\n" : "]]\n");
+        }
+    }
+    bool written = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && written;
+}
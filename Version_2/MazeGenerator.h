@@ -0,0 +1,46 @@
+#ifndef MAZEGENERATOR_H
+#define MAZEGENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+#include "MazeGrid.h"
+
+// Maze generation algorithms.
+enum MazeAlgorithm {
+    RECURSIVE_BACKTRACKER, // Perfect maze with long, winding corridors
+    PRIM, // Perfect maze with many short dead ends
+    BRAID // Recursive backtracker with dead ends opened up, so the maze has loops
+};
+
+// Settings for generateMaze.
+struct MazeGeneratorOptions {
+    int rows = 21; // Number of rows in the maze
+    int cols = 21; // Number of columns in the maze
+    MazeAlgorithm algorithm = RECURSIVE_BACKTRACKER; // Algorithm used to carve the passages
+    std::uint64_t seed = 1; // Equal seeds give equal mazes
+    double itemDensity = 0.02; // Chance for each open cell to hold an item
+    double braidFactor = 1.0; // Share of dead ends opened up by BRAID
+};
+
+// Function to generate a maze in the layout of the hand-written ones: passages on even rows and
+// columns, one-cell walls in between, START in the top-left corner and GOAL on the last
+// passage cell. Items (goggles, potions, fog) are spread over the open cells.
+// Extra memory is independent of the maze size apart from Prim's frontier, so mazes of
+// 10^8 cells fit in about 100 MB. The transition table is not built, since the generator
+// tool only writes the maze; call buildMoves() before moving agents on it.
+// Returns an empty grid if the size does not fit (mazeSizeFits).
+MazeGrid generateMaze(const MazeGeneratorOptions& options);
+
+// Function to check that a generated maze of rows x cols has room for both START and GOAL:
+// at least 3 rows or 3 columns, so GOAL does not land on START's corner.
+bool mazeSizeFits(int rows, int cols);
+
+// Function to parse an algorithm name: "backtracker", "prim" or "braid".
+bool parseMazeAlgorithm(const std::string& name, MazeAlgorithm& algorithm);
+
+// Function to write a maze in the text format, one row per line, through a fixed-size buffer.
+// Returns false on failure.
+bool writeMazeText(const std::string& fileName, const MazeGrid& maze);
+
+#endif // MAZEGENERATOR_H
@@ -0,0 +1,147 @@
+#ifndef MAZEGRID_H
+#define MAZEGRID_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "MazeElements.h"
+
+// Width of the WALL border around the maze. It covers the largest stepSize (3),
+// so a move from any cell inside the maze lands inside the buffer and needs no bounds check.
+const int MAZE_PADDING = 3;
+
+// Row and column change for one step in each Direction (NORTH, EAST, SOUTH, WEST).
+const int DIRECTION_ROW_STEP[4] = {-1, 0, 1, 0};
+const int DIRECTION_COL_STEP[4] = {0, 1, 0, -1};
+
+static_assert(MAZE_PADDING >= MAX_STEP_SIZE, "The border must cover the longest move");
+static_assert(isPassable(EMPTY) && isPassable(GOGGLES) && isPassable(SPEED_POTION) &&
+              isPassable(FOG) && isPassable(SLOWPOKE_POTION),
+              "Taking an item must not change which moves are open");
+
+// Item taken from the maze during an episode, kept so it can be put back.
+struct ConsumedCell {
+    std::size_t index; // Buffer index of the cell
+    std::uint8_t code; // Cell code before the item was taken
+};
+
+// Maze grid stored as one contiguous byte buffer, one cell code per byte,
+// surrounded by a border of WALL cells.
+struct MazeGrid {
+    int rows; // Number of rows in the maze
+    int cols; // Number of columns in the maze
+    int stride; // Distance between vertically adjacent cells in the buffer
+    std::vector<std::uint8_t> cells; // Padded cells, row-major
+    std::vector<ConsumedCell> consumed; // Items taken since the last restoreItems()
+    std::vector<std::uint16_t> moves; // Open moves of each cell, see buildMoves()
+    std::ptrdiff_t moveOffsets[4][MAX_STEP_SIZE + 1]; // Buffer offset of a move by Direction and stepSize
+
+    MazeGrid() : rows(0), cols(0), stride(0), moveOffsets() {}
+
+    // Resize the maze, filling the inside with EMPTY and the border with WALL.
+    void resize(int newRows, int newCols) {
+        rows = newRows;
+        cols = newCols;
+        stride = cols + 2 * MAZE_PADDING;
+        cells.assign(static_cast<std::size_t>(rows + 2 * MAZE_PADDING) * stride, WALL);
+        consumed.clear();
+        moves.clear();
+        for (int i = 0; i < rows; ++i) {
+            std::uint8_t* row = (*this)[i];
+            for (int j = 0; j < cols; ++j) {
+                row[j] = EMPTY;
+            }
+        }
+    }
+
+    // Build the transition table: bit (direction * MAX_STEP_SIZE + stepSize - 1) of moves[cell]
+    // is set when the cell stepSize steps away in that Direction is passable. The loaders call
+    // it once the cells are in place; call it again after changing walls. Taking and restoring
+    // items leaves it valid.
+    void buildMoves() {
+        for (int direction = 0; direction < 4; ++direction) {
+            for (int stepSize = 0; stepSize <= MAX_STEP_SIZE; ++stepSize) {
+                moveOffsets[direction][stepSize] = stepSize * directionOffset(direction);
+            }
+        }
+        moves.assign(cells.size(), 0);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                std::size_t cell = index(i, j);
+                std::uint16_t open = 0;
+                for (int direction = 0; direction < 4; ++direction) {
+                    for (int stepSize = 1; stepSize <= MAX_STEP_SIZE; ++stepSize) {
+                        if (isPassable(cells[cell + moveOffsets[direction][stepSize]])) {
+                            open |= 1u << (direction * MAX_STEP_SIZE + stepSize - 1);
+                        }
+                    }
+                }
+                moves[cell] = open;
+            }
+        }
+    }
+
+    // Buffer index reached by moving stepSize cells in a Direction from a cell, or the cell
+    // itself if the landing cell is not passable. One table load and no branch.
+    std::size_t landing(std::size_t cell, int direction, int stepSize) const {
+        std::ptrdiff_t open = -static_cast<std::ptrdiff_t>((moves[cell] >> (direction * MAX_STEP_SIZE + stepSize - 1)) & 1);
+        return cell + (moveOffsets[direction][stepSize] & open);
+    }
+
+    bool empty() const { return rows == 0; }
+
+    // Take the item at a buffer index, leaving an EMPTY cell.
+    void consume(std::size_t cellIndex) {
+        consumed.push_back({cellIndex, cells[cellIndex]});
+        cells[cellIndex] = EMPTY;
+    }
+
+    // Put back every item taken since the last call, restoring the maze as loaded.
+    // Costs one write per consumed item, so resetting between episodes stays cheap.
+    void restoreItems() {
+        for (std::size_t i = consumed.size(); i-- > 0;) {
+            cells[consumed[i].index] = consumed[i].code;
+        }
+        consumed.clear();
+    }
+
+    // Check whether (row, col) is inside the maze (not on the border).
+    bool inBounds(int row, int col) const {
+        return row >= 0 && row < rows && col >= 0 && col < cols;
+    }
+
+    // Buffer index of the cell at (row, col). Valid for positions on the border too.
+    std::size_t index(int row, int col) const {
+        return static_cast<std::size_t>(row + MAZE_PADDING) * stride + (col + MAZE_PADDING);
+    }
+
+    // Buffer offset of one step in the given Direction.
+    std::ptrdiff_t directionOffset(int direction) const {
+        return static_cast<std::ptrdiff_t>(DIRECTION_ROW_STEP[direction]) * stride + DIRECTION_COL_STEP[direction];
+    }
+
+    // FNV-1a hash of the dimensions and cells, identifying the maze in files made from it.
+    // Items taken since restoreItems() change the hash, so call it on the maze as loaded.
+    std::uint64_t hash() const {
+        std::uint64_t value = 14695981039346656037ULL;
+        auto mix = [&value](std::uint64_t byte) { value = (value ^ byte) * 1099511628211ULL; };
+        for (int shift = 0; shift < 32; shift += 8) {
+            mix((static_cast<std::uint32_t>(rows) >> shift) & 0xFF);
+            mix((static_cast<std::uint32_t>(cols) >> shift) & 0xFF);
+        }
+        for (int i = 0; i < rows; ++i) {
+            const std::uint8_t* row = (*this)[i];
+            for (int j = 0; j < cols; ++j) {
+                mix(row[j]);
+            }
+        }
+        return value;
+    }
+
+    // Unchecked access to a row, so cells can be read as maze[row][col].
+    std::uint8_t* operator[](int row) { return &cells[index(row, 0)]; }
+    const std::uint8_t* operator[](int row) const { return &cells[index(row, 0)]; }
+};
+
+#endif // MAZEGRID_H
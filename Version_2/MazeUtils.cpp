@@ -1,4 +1,5 @@
 #include "MazeUtils.h"
+#include "MazeBinary.h"
 
 #include <iostream>
 #include <fstream>
@@ -8,58 +9,112 @@
 #include <utility> // For std::pair
 #include <limits>  // For std::numeric_limits
 #include <algorithm> // For std::max_element
-#include <unordered_map>
+#include <iterator>
 
 
-std::vector<std::vector<int>> readMaze(const std::string& fileName) {
-    std::vector<std::vector<int>> maze;
+MazeGrid readMaze(const std::string& fileName) {
+    // Binary maze files are memory-mapped instead of parsed.
+    if (isMazeBinaryFile(fileName)) {
+        return readMazeBinary(fileName);
+    }
+
+    MazeGrid maze;
 
-    std::ifstream file(fileName);
-    std::string line;
+    // Read the whole file at once rather than line by line.
+    std::ifstream file(fileName, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
 
-    // Read each line from the file and convert to a vector of integers.
-    while (std::getline(file, line)) {
-        std::vector<int> row;
-        for (char ch : line) {
-            if (ch >= '0' && ch <= '9') {
-                row.push_back(ch - '0'); // Convert character to integer and add to row.
+    // Every digit is a cell. A row ends at a newline or a closing bracket, so both
+    // the one-row-per-line files and single-line JSON arrays are accepted.
+    std::vector<std::uint8_t> values; // All cells, row-major
+    int rows = 0;
+    int cols = 0;
+    int rowLength = 0;
+    for (char ch : text) {
+        if (ch >= '0' && ch <= '9') {
+            if (ch - '0' >= MAZE_ELEMENT_COUNT) {
+                std::cerr << "Error: Unknown cell code " << ch << " in row " << rows << " of " << fileName << "." << std::endl;
+                return maze;
             }
+            values.push_back(ch - '0'); // Convert character to integer and add to row.
+            rowLength++;
+        } else if ((ch == '\n' || ch == ']') && rowLength > 0) {
+            if (rows > 0 && rowLength != cols) {
+                std::cerr << "Error: Row " << rows << " of " << fileName << " has " << rowLength << " cells, expected " << cols << "." << std::endl;
+                return maze;
+            }
+            cols = rowLength;
+            rows++;
+            rowLength = 0;
+        }
+    }
+    if (rowLength > 0) {
+        if (rows > 0 && rowLength != cols) {
+            std::cerr << "Error: Row " << rows << " of " << fileName << " has " << rowLength << " cells, expected " << cols << "." << std::endl;
+            return maze;
         }
-        maze.push_back(row); // Add row to the maze.
+        cols = rowLength;
+        rows++;
     }
 
-    file.close();
+    // Copy the rows into the padded grid.
+    maze.resize(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        std::copy(values.begin() + static_cast<std::size_t>(i) * cols, values.begin() + static_cast<std::size_t>(i + 1) * cols, maze[i]);
+    }
+    maze.buildMoves();
+
     return maze; // Return the constructed maze.
 }
 
-void printMaze(const std::vector<std::vector<int>>& maze, const Agent& agent) {
-    char agentSymbol;
-    // Determine the symbol to represent the agent's direction.
-    switch (agent.direction) {
-        case NORTH: agentSymbol = '^'; break;
-        case EAST:  agentSymbol = '>'; break;
-        case SOUTH: agentSymbol = 'V'; break;
-        case WEST:  agentSymbol = '<'; break;
+void printMaze(const MazeGrid& maze, const Agent& agent) {
+    BufferedWriter out(stdout);
+    printMaze(maze, agent, out);
+}
+
+// Symbol representing the agent facing a direction.
+static char agentSymbol(Direction direction) {
+    switch (direction) {
+        case NORTH: return '^';
+        case EAST:  return '>';
+        case SOUTH: return 'V';
+        case WEST:  return '<';
     }
+    return 'X';
+}
+
+void printMaze(const MazeGrid& maze, const Agent& agent, BufferedWriter& out) {
+    char symbol = agentSymbol(agent.direction);
 
     // Iterate through the maze and print each cell.
-    for (int i = 0; i < maze.size(); ++i) {
-        for (int j = 0; j < maze[i].size(); ++j) {
+    for (int i = 0; i < maze.rows; ++i) {
+        const std::uint8_t* row = maze[i];
+        for (int j = 0; j < maze.cols; ++j) {
             // Print the agent symbol if the current cell is the agent's position.
             if (agent.position.x == i && agent.position.y == j) {
-                // Validate if the agent's position is within the bounds of the maze.
-                if (agent.position.x >= 0 && agent.position.x < maze.size() &&
-                    agent.position.y >= 0 && agent.position.y < maze[i].size()) {
-                    std::cout << agentSymbol << " "; // Display agent with its direction.
-                } else {
-                    // Handle out-of-bounds position.
-                    std::cout << "X "; // Print 'X' or other symbol for invalid position.
-                }
+                out << symbol; // Display agent with its direction.
             } else {
-                // Print the maze element for non-agent cells.
-                std::cout << maze[i][j] << " ";
+                // Print the maze element for non-agent cells (cell codes are single digits).
+                out << static_cast<char>('0' + row[j]);
             }
+            out << ' ';
         }
-        std::cout << std::endl;
+        out << '\n';
     }
-}
\ No newline at end of file
+}
+
+void drawMaze(const MazeGrid& maze, const Agent& agent, TerminalRenderer& screen) {
+    screen.follow(agent.position.x, agent.position.y);
+
+    // Only the cells in the view are copied into the frame.
+    int bottom = std::min(maze.rows, screen.top() + screen.height());
+    int right = std::min(maze.cols, screen.left() + screen.width());
+    for (int i = screen.top(); i < bottom; ++i) {
+        const std::uint8_t* row = maze[i];
+        for (int j = screen.left(); j < right; ++j) {
+            screen.set(i, j, static_cast<char>('0' + row[j]));
+        }
+    }
+    screen.set(agent.position.x, agent.position.y, agentSymbol(agent.direction));
+}
@@ -9,13 +9,24 @@
 #include <limits>  // For std::numeric_limits
 #include <algorithm> // For std::max_element
 #include <unordered_map>
+#include "MazeGrid.h"
+#include "BufferedWriter.h"
+#include "TerminalRenderer.h"
 #include "Agent.h" // Include the Agent header if you need the Agent structure in these functions
 
 struct Agent;
-// Declaration of function for reading a maze from a file
-std::vector<std::vector<int>> readMaze(const std::string& fileName);
+// Declaration of function for reading a maze from a file.
+// Accepts the text formats (one row per line or a JSON array) and binary maze files.
+MazeGrid readMaze(const std::string& fileName);
 
 // Declaration of function for printing the maze with the agent's position
-void printMaze(const std::vector<std::vector<int>>& maze, const Agent& agent);
+void printMaze(const MazeGrid& maze, const Agent& agent);
+
+// Declaration of function for printing the maze with the agent's position to a buffered writer
+void printMaze(const MazeGrid& maze, const Agent& agent, BufferedWriter& out);
+
+// Declaration of function for drawing the maze with the agent's position into the next frame
+// of a live terminal view. The view follows the agent and only its cells are drawn.
+void drawMaze(const MazeGrid& maze, const Agent& agent, TerminalRenderer& screen);
 
 #endif // MAZEUTILS_H
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../BufferedWriter.cpp"
+#include "../MazeBinary.cpp"
+#include "../MazeUtils.cpp"
+
+// Converts a text maze (maze.txt, maze_testrun_*.json, ...) into the binary maze format.
+// Usage: maze_convert <input maze> <output .mzb file>
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input maze> <output .mzb file>" << std::endl;
+        return 1;
+    }
+
+    std::string inputName = argv[1];
+    std::string outputName = argv[2];
+
+    auto maze = readMaze(inputName);
+    if (maze.empty()) {
+        std::cerr << "Error: No maze rows read from " << inputName << "." << std::endl;
+        return 1;
+    }
+
+    if (!writeMazeBinary(outputName, maze)) {
+        std::cerr << "Error: Failed to write " << outputName << "." << std::endl;
+        return 1;
+    }
+
+    // Read the header back so the summary reflects what was written.
+    MappedMazeFile file;
+    if (!file.open(outputName)) {
+        return 1;
+    }
+    const MazeFileHeader& header = file.header();
+    std::cout << "Wrote " << outputName << ": " << header.rows << "x" << header.cols
+              << ", start (" << header.startRow << ", " << header.startCol << ")"
+              << ", goal (" << header.goalRow << ", " << header.goalCol << ")" << std::endl;
+    std::cout << "Item counts:";
+    for (int code = 0; code < MAZE_ELEMENT_COUNT; ++code) {
+        std::cout << " " << code << "=" << header.itemCounts[code];
+    }
+    std::cout << std::endl;
+    return 0;
+}
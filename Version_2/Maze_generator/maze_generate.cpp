@@ -0,0 +1,68 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+
+#include "../BufferedWriter.cpp"
+#include "../MazeBinary.cpp"
+#include "../MazeGenerator.cpp"
+
+// Generates a maze and writes it as text, or in the binary maze format if the output name ends in .mzb.
+// Usage: maze_generate <rows> <cols> <output file> [--algorithm backtracker|prim|braid] [--seed N]
+//                      [--items density] [--braid fraction]
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <rows> <cols> <output file> [--algorithm backtracker|prim|braid]"
+                  << " [--seed N] [--items density] [--braid fraction]" << std::endl;
+        return 1;
+    }
+
+    MazeGeneratorOptions options;
+    options.rows = std::atoi(argv[1]);
+    options.cols = std::atoi(argv[2]);
+    std::string outputName = argv[3];
+    for (int i = 4; i < argc; i += 2) {
+        std::string arg = argv[i];
+        if (i + 1 == argc) {
+            std::cerr << "Error: Option " << arg << " needs a value." << std::endl;
+            return 1;
+        }
+        if (arg == "--algorithm") {
+            if (!parseMazeAlgorithm(argv[i + 1], options.algorithm)) {
+                std::cerr << "Error: Unknown algorithm " << argv[i + 1] << "." << std::endl;
+                return 1;
+            }
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(argv[i + 1], nullptr, 10);
+        } else if (arg == "--items") {
+            options.itemDensity = std::atof(argv[i + 1]);
+        } else if (arg == "--braid") {
+            options.braidFactor = std::atof(argv[i + 1]);
+        } else {
+            std::cerr << "Error: Unknown option " << arg << "." << std::endl;
+            return 1;
+        }
+    }
+    if (!mazeSizeFits(options.rows, options.cols)) {
+        std::cerr << "Error: The maze needs at least one row and one column, and 3 rows or 3 columns"
+                  << " to keep START and GOAL apart." << std::endl;
+        return 1;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    MazeGrid maze = generateMaze(options);
+    double generateSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    startTime = std::chrono::steady_clock::now();
+    bool binary = outputName.size() >= 4 && outputName.compare(outputName.size() - 4, 4, ".mzb") == 0;
+    bool written = binary ? writeMazeBinary(outputName, maze) : writeMazeText(outputName, maze);
+    double writeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (!written) {
+        std::cerr << "Error: Failed to write " << outputName << "." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << outputName << ": " << maze.rows << "x" << maze.cols << ", seed " << options.seed
+              << " (generated in " << generateSeconds << " s, written in " << writeSeconds << " s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,125 @@
+#ifndef MOVEHISTORY_H
+#define MOVEHISTORY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Text of an action: 1 - Turn Left, 2 - Forward, 3 - Turn Right, each then forward.
+inline const char* moveName(int action) {
+    switch (action) {
+        case 1: return "Turn Left, Forward";
+        case 3: return "Turn Right, Forward";
+        default: return "Forward";
+    }
+}
+
+// History of the actions an agent took, 2 bits per action.
+// Actions are packed 31 to a 64-bit word. A word whose 31 actions are all the same is
+// merged into a run word (action and length), so long straight stretches cost one word
+// however long they are. Recording an action allocates only when the buffer grows, and
+// text is produced only when the history is printed.
+class MoveHistory {
+public:
+    MoveHistory() : pending(0), pendingCount(0), count(0) {}
+
+    // Record an action (1, 2 or 3).
+    void push(int action) {
+        pending |= static_cast<std::uint64_t>(action & ACTION_MASK) << (2 * pendingCount);
+        count++;
+        if (++pendingCount == ACTIONS_PER_WORD) {
+            flushPending();
+        }
+    }
+
+    void clear() {
+        words.clear();
+        pending = 0;
+        pendingCount = 0;
+        count = 0;
+    }
+
+    // Number of actions recorded.
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Bytes used by the recorded actions.
+    std::size_t memoryBytes() const { return words.capacity() * sizeof(std::uint64_t) + sizeof(*this); }
+
+    // Call visit(action, length) for each run of equal actions, in order.
+    template <typename Visit>
+    void forEachRun(Visit visit) const {
+        int runAction = 0;
+        std::uint64_t runLength = 0;
+        auto add = [&](int action, std::uint64_t length) {
+            if (action == runAction) {
+                runLength += length;
+                return;
+            }
+            if (runLength > 0) {
+                visit(runAction, runLength);
+            }
+            runAction = action;
+            runLength = length;
+        };
+        for (std::uint64_t word : words) {
+            if (word >> TAG_SHIFT == RUN_TAG) {
+                add(static_cast<int>(word & ACTION_MASK), (word & ~(3ULL << TAG_SHIFT)) >> 2);
+            } else {
+                for (int i = 0; i < ACTIONS_PER_WORD; ++i) {
+                    add(static_cast<int>((word >> (2 * i)) & ACTION_MASK), 1);
+                }
+            }
+        }
+        for (int i = 0; i < pendingCount; ++i) {
+            add(static_cast<int>((pending >> (2 * i)) & ACTION_MASK), 1);
+        }
+        if (runLength > 0) {
+            visit(runAction, runLength);
+        }
+    }
+
+    // Write the history as "List of moves: " followed by each run, "Forward x3; " for a run of
+    // three, and a newline. Stream is std::ostream or BufferedWriter.
+    template <typename Stream>
+    void printRuns(Stream& out) const {
+        out << "List of moves: ";
+        forEachRun([&](int action, std::uint64_t length) {
+            out << moveName(action);
+            if (length > 1) {
+                out << " x" << static_cast<long long>(length);
+            }
+            out << "; ";
+        });
+        out << '\n';
+    }
+
+private:
+    static const int ACTIONS_PER_WORD = 31; // Bits 62-63 tag the word
+    static const int TAG_SHIFT = 62;
+    static const std::uint64_t RUN_TAG = 1; // Tag of a run word: bits 0-1 action, bits 2-61 length
+    static const std::uint64_t ACTION_MASK = 3;
+
+    // Store the full pending word, as a run if all its actions are equal.
+    void flushPending() {
+        std::uint64_t first = pending & ACTION_MASK;
+        if (pending == first * 0x1555555555555555ULL) { // first repeated in all 31 slots
+            if (!words.empty() && words.back() >> TAG_SHIFT == RUN_TAG && (words.back() & ACTION_MASK) == first) {
+                words.back() += static_cast<std::uint64_t>(ACTIONS_PER_WORD) << 2;
+            } else {
+                words.push_back((RUN_TAG << TAG_SHIFT) | (static_cast<std::uint64_t>(ACTIONS_PER_WORD) << 2) | first);
+            }
+        } else {
+            words.push_back(pending);
+        }
+        pending = 0;
+        pendingCount = 0;
+    }
+
+    std::vector<std::uint64_t> words; // Full words of packed actions and run words
+    std::uint64_t pending; // Actions not yet filling a word
+    int pendingCount; // Number of actions in pending
+    std::size_t count; // Number of actions recorded
+};
+
+#endif // MOVEHISTORY_H
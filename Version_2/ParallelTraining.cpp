@@ -0,0 +1,39 @@
+#include "ParallelTraining.h"
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "AgentUtils.h"
+
+std::vector<SeedResult> trainSeeds(const MazeGrid& maze, const TrainingOptions& options) {
+    std::vector<SeedResult> results(options.seeds);
+
+    int threadCount = options.threads > 0 ? options.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, std::min(threadCount, options.seeds));
+
+    // Workers take the next untrained seed until none are left.
+    std::atomic<int> nextSeed(0);
+    auto worker = [&]() {
+        MazeGrid workerMaze = maze; // One private copy per worker, reused for all its seeds
+        int index;
+        while ((index = nextSeed.fetch_add(1)) < options.seeds) {
+            std::uint64_t seed = options.seed + index;
+            Agent agent = initializeAgent(workerMaze, seed);
+            applyTrainingOptions(agent, options);
+
+            results[index].seed = seed;
+            results[index].summary = trainAgent(agent, workerMaze, options, nullptr);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    return results;
+}
@@ -0,0 +1,20 @@
+#ifndef PARALLELTRAINING_H
+#define PARALLELTRAINING_H
+
+#include <vector>
+
+#include "MazeGrid.h"
+#include "Training.h"
+
+// Result of training one independently seeded agent.
+struct SeedResult {
+    std::uint64_t seed; // Seed of the agent's random number generator
+    TrainingSummary summary; // Outcome of the agent's training run
+};
+
+// Function to train options.seeds independent agents, seeded options.seed, options.seed + 1, ...,
+// on a pool of worker threads. Every worker reads the shared maze and trains on its own copy,
+// since agents take items during an episode. Results are returned in seed order.
+std::vector<SeedResult> trainSeeds(const MazeGrid& maze, const TrainingOptions& options);
+
+#endif // PARALLELTRAINING_H
@@ -0,0 +1,145 @@
+#include "QCheckpoint.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Bytes of Q-values that follow a header.
+static std::uint64_t checkpointValueBytes(const QCheckpointHeader& header) {
+    return static_cast<std::uint64_t>(header.rows) * header.cols * header.actions * header.valueSize;
+}
+
+QCheckpointHeader makeQCheckpointHeader() {
+    QCheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Q_CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = Q_CHECKPOINT_VERSION;
+    return header;
+}
+
+bool writeQCheckpoint(const std::string& fileName, const QCheckpointHeader& header, const void* values) {
+    std::string temporaryName = fileName + ".tmp";
+    std::FILE* file = std::fopen(temporaryName.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "Failed to open file: " << temporaryName << std::endl;
+        return false;
+    }
+
+    std::size_t bytes = static_cast<std::size_t>(checkpointValueBytes(header));
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (bytes == 0 || std::fwrite(values, 1, bytes, file) == bytes);
+    ok = std::fclose(file) == 0 && ok;
+
+#ifdef _WIN32
+    std::remove(fileName.c_str()); // rename does not replace an existing file here
+#endif
+    if (!ok || std::rename(temporaryName.c_str(), fileName.c_str()) != 0) {
+        std::cerr << "Failed to write file: " << fileName << std::endl;
+        std::remove(temporaryName.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<void> mapQCheckpoint(const std::string& fileName, QCheckpointHeader& header, void*& values) {
+    std::shared_ptr<void> handle;
+    unsigned char* data = nullptr;
+    std::size_t size = 0;
+
+#ifdef _WIN32
+    // No mmap here, so read the whole file in one go instead.
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << fileName << std::endl;
+        return nullptr;
+    }
+    size = static_cast<std::size_t>(file.tellg());
+    auto buffer = std::make_shared<std::vector<std::uint64_t> >((size + 7) / 8);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer->data()), size);
+    data = reinterpret_cast<unsigned char*>(buffer->data());
+    handle = buffer;
+#else
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open file: " << fileName << std::endl;
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        std::cerr << "Failed to read file: " << fileName << std::endl;
+        return nullptr;
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    // Private and writable: training changes its own copy of a page, never the file.
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping stays valid after the descriptor is closed.
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map file: " << fileName << std::endl;
+        return nullptr;
+    }
+    data = static_cast<unsigned char*>(mapping);
+    handle = std::shared_ptr<void>(mapping, [size](void* address) { munmap(address, size); });
+#endif
+
+    // Validate the header and that the file holds every value it promises.
+    // Version 1 headers are shorter; the fields they lack read as zero.
+    if (size < Q_CHECKPOINT_V1_HEADER_SIZE) {
+        std::cerr << "Error: " << fileName << " is not a valid checkpoint file." << std::endl;
+        return nullptr;
+    }
+    header = makeQCheckpointHeader();
+    std::memcpy(&header, data, Q_CHECKPOINT_V1_HEADER_SIZE);
+    std::size_t headerSize = header.version == 1 ? Q_CHECKPOINT_V1_HEADER_SIZE : sizeof(QCheckpointHeader);
+    if (std::memcmp(header.magic, Q_CHECKPOINT_MAGIC, sizeof(Q_CHECKPOINT_MAGIC)) != 0 ||
+        (header.version != 1 && header.version != Q_CHECKPOINT_VERSION) || size < headerSize ||
+        size - headerSize < checkpointValueBytes(header)) {
+        std::cerr << "Error: " << fileName << " is not a valid checkpoint file." << std::endl;
+        return nullptr;
+    }
+    std::memcpy(&header, data, headerSize);
+    values = data + headerSize;
+    return handle;
+}
+
+QCheckpointWriter::QCheckpointWriter() : busy(false), failed(false) {}
+
+QCheckpointWriter::~QCheckpointWriter() {
+    wait();
+}
+
+bool QCheckpointWriter::writeAsync(const std::string& fileName, const QCheckpointHeader& header, const void* values) {
+    if (busy) {
+        return false;
+    }
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(values);
+    snapshot.assign(bytes, bytes + checkpointValueBytes(header));
+    busy = true;
+    writer = std::thread([this, fileName, header]() {
+        if (!writeQCheckpoint(fileName, header, snapshot.data())) {
+            failed = true;
+        }
+        busy = false;
+    });
+    return true;
+}
+
+bool QCheckpointWriter::wait() {
+    if (writer.joinable()) {
+        writer.join();
+    }
+    return !failed;
+}
@@ -0,0 +1,83 @@
+#ifndef QCHECKPOINT_H
+#define QCHECKPOINT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+// Q-table checkpoint file (.qck) layout:
+//   QCheckpointHeader, followed by rows * cols * actions Q-values of valueSize bytes, row-major.
+// The header is 128 bytes, so the values of a mapped file are aligned for vector loads.
+// Fields are stored in native (little-endian) byte order.
+// Version 1 files have a 64-byte header without the exploration policy fields; they are read
+// as epsilon-greedy at a constant rate.
+const char Q_CHECKPOINT_MAGIC[4] = {'Q', 'C', 'K', 'P'};
+const std::uint32_t Q_CHECKPOINT_VERSION = 2;
+
+struct QCheckpointHeader {
+    char magic[4];              // Always Q_CHECKPOINT_MAGIC
+    std::uint32_t version;      // Format version, Q_CHECKPOINT_VERSION
+    std::uint64_t mazeHash;     // Hash of the maze the table was trained on
+    std::uint32_t rows;         // Number of rows in the maze
+    std::uint32_t cols;         // Number of columns in the maze
+    std::uint32_t actions;      // Q-values per cell
+    std::uint32_t valueSize;    // Bytes per Q-value: 8 for double, 4 for float, 2 for half
+    double learningRate;        // Learning rate the table was trained with
+    double discountFactor;      // Discount factor the table was trained with
+    double explorationRate;     // Exploration rate the table was trained with, the start of its schedule
+    std::uint64_t episodes;     // Episodes the table has been trained for
+    std::uint32_t explorationStrategy; // ExplorationStrategy the table was trained with
+    std::uint32_t decaySchedule; // DecaySchedule of the exploration rate
+    double explorationMin;      // Exploration rate the decay ends at
+    std::uint32_t decayEpisodes; // Length of the decay in episodes
+    std::uint32_t reserved[11]; // Zero
+};
+
+// Size of the header of version 1 files, which ends after episodes.
+const std::size_t Q_CHECKPOINT_V1_HEADER_SIZE = 64;
+
+static_assert(sizeof(QCheckpointHeader) == 128, "Checkpoint header must stay 128 bytes");
+
+// Function to fill the magic and version of a checkpoint header and zero the rest.
+QCheckpointHeader makeQCheckpointHeader();
+
+// Function to write a checkpoint: the header and header.rows * cols * actions values of
+// header.valueSize bytes. The file is written under a temporary name and renamed over
+// fileName, so a reader never sees half a checkpoint. Returns false on failure.
+bool writeQCheckpoint(const std::string& fileName, const QCheckpointHeader& header, const void* values);
+
+// Function to map a checkpoint file copy-on-write: values can be read and changed at once,
+// pages are read from disk as they are touched, and the file itself is never modified.
+// Returns a handle that keeps the mapping alive, or null if the file is not a valid
+// checkpoint. header and values are set on success; a version 1 header is returned with
+// the fields it lacks zeroed.
+std::shared_ptr<void> mapQCheckpoint(const std::string& fileName, QCheckpointHeader& header, void*& values);
+
+// Writes checkpoints from a background thread. The values are copied when a write starts,
+// so training goes on changing them while the file is written.
+class QCheckpointWriter {
+public:
+    QCheckpointWriter();
+    ~QCheckpointWriter();
+    QCheckpointWriter(const QCheckpointWriter&) = delete;
+    QCheckpointWriter& operator=(const QCheckpointWriter&) = delete;
+
+    // Start writing a checkpoint. Returns false without copying anything if the previous
+    // checkpoint is still being written, so the caller never waits for the disk.
+    bool writeAsync(const std::string& fileName, const QCheckpointHeader& header, const void* values);
+
+    // Wait for the checkpoint being written. Returns false if any write failed.
+    bool wait();
+
+private:
+    std::thread writer; // Thread writing the latest checkpoint
+    std::vector<unsigned char> snapshot; // Copy of the values being written
+    std::atomic<bool> busy; // Whether a checkpoint is being written
+    std::atomic<bool> failed; // Whether a write failed
+};
+
+#endif // QCHECKPOINT_H
@@ -0,0 +1,93 @@
+#include "QTable.h"
+
+#include <algorithm>
+
+QTable::QTable() : rows(0), cols(0), actions(0), storage(nullptr) {}
+
+QTable::QTable(int newRows, int newCols, int newActions) : rows(0), cols(0), actions(0), storage(nullptr) {
+    resize(newRows, newCols, newActions);
+}
+
+QTable::QTable(const QTable& other)
+    : rows(other.rows), cols(other.cols), actions(other.actions),
+      values(other.storage, other.storage + other.size()) {
+    storage = values.data();
+}
+
+QTable::QTable(QTable&& other)
+    : rows(other.rows), cols(other.cols), actions(other.actions), storage(other.storage),
+      values(std::move(other.values)), owner(std::move(other.owner)) {
+    other.rows = other.cols = other.actions = 0;
+    other.storage = nullptr;
+}
+
+QTable& QTable::operator=(const QTable& other) {
+    if (this != &other) {
+        rows = other.rows;
+        cols = other.cols;
+        actions = other.actions;
+        values.assign(other.storage, other.storage + other.size());
+        storage = values.data();
+        owner.reset();
+    }
+    return *this;
+}
+
+QTable& QTable::operator=(QTable&& other) {
+    if (this != &other) {
+        rows = other.rows;
+        cols = other.cols;
+        actions = other.actions;
+        storage = other.storage;
+        values = std::move(other.values);
+        owner = std::move(other.owner);
+        other.rows = other.cols = other.actions = 0;
+        other.storage = nullptr;
+    }
+    return *this;
+}
+
+void QTable::resize(int newRows, int newCols, int newActions) {
+    rows = newRows;
+    cols = newCols;
+    actions = newActions;
+    values.assign(static_cast<std::size_t>(rows) * cols * actions, 0.0);
+    storage = values.data();
+    owner.reset();
+}
+
+void QTable::attach(int newRows, int newCols, int newActions, double* external, std::shared_ptr<void> newOwner) {
+    rows = newRows;
+    cols = newCols;
+    actions = newActions;
+    values.clear();
+    values.shrink_to_fit();
+    storage = external;
+    owner = std::move(newOwner);
+}
+
+void QTable::fill(double value) {
+    std::fill(storage, storage + size(), value);
+}
+
+double QTable::maxValue(int r, int c) const {
+    const double* q = row(r, c);
+    double best = q[0];
+    for (int a = 1; a < actions; ++a) {
+        if (q[a] > best) {
+            best = q[a];
+        }
+    }
+    return best;
+}
+
+int QTable::bestAction(int r, int c) const {
+    const double* q = row(r, c);
+    int best = 0;
+    for (int a = 1; a < actions; ++a) {
+        if (q[a] > q[best]) {
+            best = a;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,68 @@
+#ifndef QTABLE_H
+#define QTABLE_H
+
+#include <vector>
+#include <cstddef>
+#include <memory>
+
+// Dense Q-table for storing state-action values.
+// All values live in one contiguous rows * cols * actions array, so the
+// Q-values of a cell sit next to each other and a lookup is a single index.
+// The array is either owned by the table or attached from elsewhere, such as a
+// memory-mapped checkpoint; copies always own their values.
+class QTable {
+public:
+    QTable();
+    QTable(int rows, int cols, int actions);
+    QTable(const QTable& other);
+    QTable(QTable&& other);
+    QTable& operator=(const QTable& other);
+    QTable& operator=(QTable&& other);
+
+    // Resize the table and reset every Q-value to zero.
+    void resize(int rows, int cols, int actions);
+
+    // Use rows * cols * actions Q-values stored outside the table instead of its own.
+    // owner keeps the storage alive for as long as the table uses it.
+    void attach(int rows, int cols, int actions, double* external, std::shared_ptr<void> owner);
+
+    // Set every Q-value to the given value.
+    void fill(double value);
+
+    // Pointer to the first Q-value of the cell at (row, col).
+    double* row(int r, int c) { return &storage[index(r, c)]; }
+    const double* row(int r, int c) const { return &storage[index(r, c)]; }
+
+    // Q-value of taking the action (0-based index) in the cell at (row, col).
+    double& at(int r, int c, int action) { return storage[index(r, c) + action]; }
+    double at(int r, int c, int action) const { return storage[index(r, c) + action]; }
+
+    // All rows * cols * actions Q-values, row-major.
+    double* data() { return storage; }
+    const double* data() const { return storage; }
+    std::size_t size() const { return static_cast<std::size_t>(rows) * cols * actions; }
+
+    // Highest Q-value of the cell at (row, col).
+    double maxValue(int r, int c) const;
+
+    // Index of the action with the highest Q-value in the cell at (row, col).
+    int bestAction(int r, int c) const;
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getActions() const { return actions; }
+
+private:
+    std::size_t index(int r, int c) const {
+        return (static_cast<std::size_t>(r) * cols + c) * actions;
+    }
+
+    int rows;
+    int cols;
+    int actions;
+    double* storage; // The Q-values in use: values.data() or attached storage
+    std::vector<double> values; // rows * cols * actions Q-values, row-major, unless attached
+    std::shared_ptr<void> owner; // Keeps attached storage alive
+};
+
+#endif // QTABLE_H
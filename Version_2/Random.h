@@ -0,0 +1,72 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+// Small, fast random number generator (xoshiro256**) with explicit seeding.
+// Each agent owns one, so runs are reproducible and agents can run on separate threads.
+// Also usable as a standard UniformRandomBitGenerator (e.g. with std::shuffle).
+class RandomGenerator {
+public:
+    typedef std::uint64_t result_type;
+
+    explicit RandomGenerator(std::uint64_t seedValue = 1) { seed(seedValue); }
+
+    // Reset the generator. The seed is expanded with splitmix64, so nearby seeds give unrelated streams.
+    void seed(std::uint64_t seedValue) {
+        for (int i = 0; i < 4; ++i) {
+            seedValue += 0x9E3779B97F4A7C15ULL;
+            std::uint64_t z = seedValue;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            state[i] = z ^ (z >> 31);
+        }
+    }
+
+    // Next 64 random bits.
+    std::uint64_t next() {
+        std::uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+        std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotateLeft(state[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [0, bound), bound > 0. Uses a multiply instead of a division,
+    // rejecting the few values that would bias the result.
+    std::uint32_t nextBelow(std::uint32_t bound) {
+        std::uint64_t product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(next() >> 32)) * bound;
+        std::uint32_t low = static_cast<std::uint32_t>(product);
+        if (low < bound) {
+            std::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(next() >> 32)) * bound;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32);
+    }
+
+    // Uniform double in [0, 1).
+    double nextDouble() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()() { return next(); }
+
+private:
+    static std::uint64_t rotateLeft(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t state[4];
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+
+#include "../QTable.cpp"
+#include "../BufferedWriter.cpp"
+#include "../MazeBinary.cpp"
+#include "../MazeUtils.cpp"
+#include "../AgentUtils.cpp"
+#include "../Solver.cpp"
+#include "../ItemPlanner.cpp"
+
+// Finds the shortest action sequence from START to GOAL as a baseline for the agents.
+// Usage: solve [maze file] [--items]
+// With --items the search also tracks which potions have been consumed.
+int main(int argc, char* argv[]) {
+    std::string fileName = "../maze.txt";
+    bool trackItems = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--items") {
+            trackItems = true;
+        } else {
+            fileName = arg;
+        }
+    }
+
+    auto maze = readMaze(fileName);
+    if (maze.empty()) {
+        std::cerr << "Error: Failed to load maze " << fileName << std::endl;
+        return 1;
+    }
+
+    // Only the search asked for is run, so the time is its own.
+    auto startTime = std::chrono::steady_clock::now();
+    SolverResult result;
+    int potionsTaken = 0;
+    if (trackItems) {
+        ItemRoute route = planItemRoute(maze);
+        result = {route.solved, route.length, route.actions, route.statesExpanded};
+        potionsTaken = route.potionsTaken;
+    } else {
+        result = solveMaze(maze);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (!result.solved) {
+        std::cout << "No route to the goal (" << result.statesExpanded << " states expanded, " << seconds << " s)" << std::endl;
+        return 1;
+    }
+
+    if (trackItems) {
+        std::cout << "Potions taken: " << potionsTaken << std::endl;
+    }
+    std::cout << "Shortest route: " << result.length << " steps (" << result.statesExpanded << " states expanded, " << seconds << " s)" << std::endl;
+    std::cout << "List of moves: ";
+    for (int action : result.actions) {
+        std::cout << (action == 1 ? "Turn Left, Forward" : action == 3 ? "Turn Right, Forward" : "Forward") << "; ";
+    }
+    std::cout << std::endl;
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "Solver.h"
+
+#include <cstdint>
+#include <algorithm>
+
+#include "Agent.h"
+#include "MazeElements.h"
+
+static const int DIRECTIONS = 4;
+static const int SOLVER_ACTIONS = 3; // 1 - Turn Left, 2 - Forward, 3 - Turn Right
+
+// Per-state search record, one byte per state:
+// bits 0-1 action - 1, bits 2-3 stepSize - 1 before the action, bit 4 set if the agent moved,
+// bit 6 marks the start state, bit 7 marks a visited state.
+static const std::uint8_t VISITED = 0x80;
+static const std::uint8_t START_STATE = 0x40;
+static const std::uint8_t MOVED = 0x10;
+
+SolverResult solveMaze(const MazeGrid& maze) {
+    SolverResult result = {false, -1, {}, 0};
+
+    // Find START.
+    int startRow = -1, startCol = -1;
+    for (int i = 0; i < maze.rows && startRow < 0; ++i) {
+        for (int j = 0; j < maze.cols; ++j) {
+            if (maze[i][j] == START) {
+                startRow = i;
+                startCol = j;
+                break;
+            }
+        }
+    }
+    if (startRow < 0) {
+        return result;
+    }
+
+    // State id: (cell buffer index << 4) | (direction << 2) | (stepSize - 1), so decoding is
+    // shifts and masks, and the twelve states of a cell share a cache line.
+    std::vector<std::uint8_t> record(maze.cells.size() << 4, 0);
+    std::vector<std::uint32_t> queue;
+    queue.reserve(static_cast<std::size_t>(maze.rows) * maze.cols);
+
+    std::ptrdiff_t offsets[DIRECTIONS];
+    for (int direction = 0; direction < DIRECTIONS; ++direction) {
+        offsets[direction] = maze.directionOffset(direction);
+    }
+
+    std::uint32_t start = (static_cast<std::uint32_t>(maze.index(startRow, startCol)) << 4) | (EAST << 2);
+    record[start] = VISITED | START_STATE;
+    queue.push_back(start);
+
+    std::uint32_t goal = start;
+    bool found = maze[startRow][startCol] == GOAL;
+
+    for (std::size_t head = 0; head < queue.size() && !found; ++head) {
+        std::uint32_t state = queue[head];
+        result.statesExpanded++;
+
+        int stepSize = (state & 0x03) + 1;
+        int direction = (state >> 2) & 0x03;
+        std::size_t cell = state >> 4;
+
+        for (int action = 1; action <= SOLVER_ACTIONS; ++action) {
+            // Turn as in turnAgent: 1 turns left, 3 turns right, 2 keeps the direction.
+            int newDirection = (direction + action + 2) & 0x03;
+
+            // Move as in moveAgent, through the maze's transition table.
+            std::size_t newCell = maze.landing(cell, newDirection, stepSize);
+            bool moved = newCell != cell;
+
+            int cellCode = maze.cells[newCell];
+            std::uint32_t next = (static_cast<std::uint32_t>(newCell) << 4) | (newDirection << 2) | (stepSizeAfter(stepSize, cellCode) - 1);
+            if (record[next] & VISITED) {
+                continue;
+            }
+            record[next] = VISITED | (moved ? MOVED : 0) | ((stepSize - 1) << 2) | (action - 1);
+            if (cellCode == GOAL) {
+                goal = next;
+                found = true;
+                break;
+            }
+            queue.push_back(next);
+        }
+    }
+
+    if (!found) {
+        return result;
+    }
+
+    // Walk the records back from the goal to recover the actions.
+    std::uint32_t state = goal;
+    while (!(record[state] & START_STATE)) {
+        std::uint8_t info = record[state];
+        int action = (info & 0x03) + 1;
+        int previousStepSize = ((info >> 2) & 0x03) + 1;
+        int direction = (state >> 2) & 0x03;
+        std::size_t cell = state >> 4;
+
+        // Undo the move, then the turn.
+        if (info & MOVED) {
+            cell -= previousStepSize * offsets[direction];
+        }
+        int previousDirection = (direction - action + 2 + DIRECTIONS) & 0x03;
+
+        result.actions.push_back(action);
+        state = (static_cast<std::uint32_t>(cell) << 4) | (previousDirection << 2) | (previousStepSize - 1);
+    }
+    std::reverse(result.actions.begin(), result.actions.end());
+
+    result.solved = true;
+    result.length = result.actions.size();
+    return result;
+}
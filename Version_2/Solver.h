@@ -0,0 +1,22 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <vector>
+
+#include "MazeGrid.h"
+
+// Shortest route found by the solver.
+struct SolverResult {
+    bool solved; // Whether the GOAL cell can be reached from START
+    int length; // Number of actions on the shortest route, -1 if unsolved
+    std::vector<int> actions; // Actions in order: 1 - Turn Left, 2 - Forward, 3 - Turn Right, each then forward
+    long long statesExpanded; // Number of search states taken off the queue
+};
+
+// Function to find the shortest action sequence from START to GOAL with breadth-first search
+// over (position, direction, stepSize). Moves follow turnAgent, moveAgent and the stepSize
+// effects of updateAgentState, starting like initializeAgent (facing EAST, stepSize 1).
+// Items are treated as never consumed; use the item-aware planner when that matters.
+SolverResult solveMaze(const MazeGrid& maze);
+
+#endif // SOLVER_H
@@ -0,0 +1,181 @@
+#ifndef TERMINALRENDERER_H
+#define TERMINALRENDERER_H
+
+#include <cstdio>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+// Live view of a maze in an ANSI terminal.
+// Cells are drawn as "c " like printMaze. Each frame is built in a buffer allocated up front;
+// present() compares it with what is on the screen, moves the cursor only to the cells that
+// changed and sends the whole update with one write. Mazes larger than the terminal are
+// shown through a viewport that follows the agent.
+class TerminalRenderer {
+public:
+    // Renderer for a rows x cols maze. A view size of 0 fits the terminal.
+    TerminalRenderer(int rows, int cols, int viewRows = 0, int viewCols = 0)
+        : rows(rows), cols(cols), viewTop(0), viewLeft(0), drawn(false), cursorRow(-1), cursorCol(-1) {
+        int terminalRows = 24;
+        int terminalCols = 80;
+        terminalSize(terminalRows, terminalCols);
+        // Leave a line for the status and one for input.
+        viewHeight = std::max(1, std::min(rows, viewRows > 0 ? viewRows : terminalRows - 2));
+        viewWidth = std::max(1, std::min(cols, viewCols > 0 ? viewCols : terminalCols / 2));
+        frame.assign(static_cast<std::size_t>(viewHeight) * viewWidth, ' ');
+        screen.assign(frame.size(), '\0');
+        // Room for a full redraw: every cell with one cursor move per row, plus the status line.
+        out.reserve(frame.size() * 2 + static_cast<std::size_t>(viewHeight) * 12 + 256);
+    }
+
+    // First maze row and column in the view, and the size of the view.
+    int top() const { return viewTop; }
+    int left() const { return viewLeft; }
+    int height() const { return viewHeight; }
+    int width() const { return viewWidth; }
+
+    // Scroll the view so (row, col) stays clear of its edges. The view only moves when
+    // the cell gets within a quarter of the view of an edge, so a moving agent does not
+    // shift the whole picture every step.
+    void follow(int row, int col) {
+        viewTop = scrollTo(viewTop, viewHeight, rows, row);
+        viewLeft = scrollTo(viewLeft, viewWidth, cols, col);
+    }
+
+    // Set the character of the cell at maze (row, col) in the next frame. Cells outside
+    // the view are ignored.
+    void set(int row, int col, char symbol) {
+        int r = row - viewTop;
+        int c = col - viewLeft;
+        if (r >= 0 && r < viewHeight && c >= 0 && c < viewWidth) {
+            frame[static_cast<std::size_t>(r) * viewWidth + c] = symbol;
+        }
+    }
+
+    // Set the line shown below the maze.
+    // The text is copied into a buffer that is reused from frame to frame.
+    void setStatus(const char* text) { status.assign(text); }
+    void setStatus(const std::string& text) { status.assign(text); }
+
+    // Put the next frame on the screen. The first frame clears the screen and draws every
+    // cell; later ones rewrite only the cells that differ from the screen.
+    void present() {
+        out.clear();
+        cursorRow = cursorCol = -1; // Typed input may have moved it
+        if (!drawn) {
+            out += "\x1b[2J";
+            std::fill(screen.begin(), screen.end(), '\0');
+            drawn = true;
+        }
+        for (int r = 0; r < viewHeight; ++r) {
+            const char* next = &frame[static_cast<std::size_t>(r) * viewWidth];
+            char* shown = &screen[static_cast<std::size_t>(r) * viewWidth];
+            for (int c = 0; c < viewWidth; ++c) {
+                if (next[c] != shown[c]) {
+                    moveCursor(r + 1, 2 * c + 1);
+                    out += next[c];
+                    out += ' ';
+                    cursorCol += 2;
+                    shown[c] = next[c];
+                }
+            }
+        }
+        // The status is short, so it is rewritten every frame. The cursor is left after it,
+        // where typed input appears.
+        moveCursor(viewHeight + 1, 1);
+        out += status;
+        out += "\x1b[J"; // Clear the rest of the screen, such as echoed input
+        flushOut();
+    }
+
+    // Forget what is on the screen, so the next frame is drawn in full. Use it after other
+    // output has been written to the terminal.
+    void invalidate() { drawn = false; }
+
+    // Move the cursor below the frame, so normal output can follow it.
+    void release() {
+        out.clear();
+        moveCursor(viewHeight + 2, 1);
+        flushOut();
+        drawn = false;
+    }
+
+    // Size of the terminal on standard output. Returns false, leaving the arguments
+    // unchanged, if it is not a terminal.
+    static bool terminalSize(int& terminalRows, int& terminalCols) {
+#ifndef _WIN32
+        struct winsize size;
+        if (isatty(STDOUT_FILENO) && ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0) {
+            terminalRows = size.ws_row;
+            terminalCols = size.ws_col;
+            return true;
+        }
+#endif
+        return false;
+    }
+
+private:
+    // New first row (or column) of a view of the given size so that target is at least a
+    // quarter of the view from its edges, kept within the maze.
+    static int scrollTo(int first, int size, int total, int target) {
+        int margin = size / 4;
+        if (target < first + margin) {
+            first = target - margin;
+        } else if (target >= first + size - margin) {
+            first = target - size + margin + 1;
+        }
+        return std::max(0, std::min(first, total - size));
+    }
+
+    // Append an ANSI cursor move to (row, col), counting from 1, unless the cursor is there.
+    void moveCursor(int row, int col) {
+        if (row == cursorRow && col == cursorCol) {
+            return;
+        }
+        char command[32];
+        int length = std::snprintf(command, sizeof(command), "\x1b[%d;%dH", row, col);
+        out.append(command, static_cast<std::size_t>(length));
+        cursorRow = row;
+        cursorCol = col;
+    }
+
+    // Send the buffered update to standard output in one write.
+    void flushOut() {
+        std::fflush(stdout); // Anything printed through stdio goes first
+#ifndef _WIN32
+        std::size_t written = 0;
+        while (written < out.size()) {
+            ssize_t count = ::write(STDOUT_FILENO, out.data() + written, out.size() - written);
+            if (count <= 0) {
+                break;
+            }
+            written += static_cast<std::size_t>(count);
+        }
+#else
+        std::fwrite(out.data(), 1, out.size(), stdout);
+        std::fflush(stdout);
+#endif
+    }
+
+    int rows; // Number of rows in the maze
+    int cols; // Number of columns in the maze
+    int viewHeight; // Maze rows shown
+    int viewWidth; // Maze columns shown
+    int viewTop; // First maze row shown
+    int viewLeft; // First maze column shown
+    bool drawn; // Whether screen holds what the terminal shows
+    int cursorRow; // Terminal row of the cursor, counting from 1, -1 if unknown
+    int cursorCol; // Terminal column of the cursor, counting from 1, -1 if unknown
+    std::vector<char> frame; // Next frame, one character per cell of the view
+    std::vector<char> screen; // Characters on the terminal, '\0' where unknown
+    std::string status; // Status line of the next frame
+    std::string out; // Escape sequences and characters of the update being built
+};
+
+#endif // TERMINALRENDERER_H
@@ -0,0 +1,486 @@
+#include "Training.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <cstdio>
+
+#include "AgentUtils.h"
+#include "MazeUtils.h"
+#include "MazeElements.h"
+#include "QCheckpoint.h"
+
+bool parseTrainingOptions(int argc, char* argv[], TrainingOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        // Options that take a value read it from the next argument.
+        bool hasValue = i + 1 < argc;
+        if (arg == "--episodes" && hasValue) {
+            options.episodes = std::atoi(argv[++i]);
+        } else if (arg == "--max-steps" && hasValue) {
+            options.maxSteps = std::atoi(argv[++i]);
+        } else if (arg == "--render-every" && hasValue) {
+            options.renderEvery = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seeds" && hasValue) {
+            options.seeds = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--convergence-window" && hasValue) {
+            options.convergenceWindow = std::atoi(argv[++i]);
+        } else if (arg == "--learning-rate" && hasValue) {
+            options.learningRate = std::atof(argv[++i]);
+        } else if (arg == "--discount" && hasValue) {
+            options.discountFactor = std::atof(argv[++i]);
+        } else if (arg == "--exploration" && hasValue) {
+            options.explorationRate = std::atof(argv[++i]);
+        } else if (arg == "--policy" && hasValue) {
+            ExplorationStrategy strategy;
+            if (!parseExplorationStrategy(argv[++i], strategy)) {
+                std::cerr << "Error: --policy must be epsilon, softmax or ucb." << std::endl;
+                return false;
+            }
+            options.policy = strategy;
+        } else if (arg == "--decay" && hasValue) {
+            DecaySchedule decay;
+            if (!parseDecaySchedule(argv[++i], decay)) {
+                std::cerr << "Error: --decay must be constant, linear or exponential." << std::endl;
+                return false;
+            }
+            options.decay = decay;
+        } else if (arg == "--exploration-min" && hasValue) {
+            options.explorationMin = std::atof(argv[++i]);
+            if (options.explorationMin < 0.0) {
+                std::cerr << "Error: --exploration-min must not be negative." << std::endl;
+                return false;
+            }
+        } else if (arg == "--decay-episodes" && hasValue) {
+            options.decayEpisodes = std::atoi(argv[++i]);
+            if (options.decayEpisodes < 0) {
+                std::cerr << "Error: --decay-episodes must not be negative." << std::endl;
+                return false;
+            }
+        } else if (arg == "--planning-steps" && hasValue) {
+            options.planningSteps = std::atoi(argv[++i]);
+        } else if (arg == "--planning-queue" && hasValue) {
+            options.planningQueue = std::atoi(argv[++i]);
+        } else if (arg == "--lambda" && hasValue) {
+            options.lambda = std::atof(argv[++i]);
+        } else if (arg == "--trace-capacity" && hasValue) {
+            options.traceCapacity = std::atoi(argv[++i]);
+        } else if (arg == "--evaluate" && hasValue) {
+            options.evaluateAgents = std::atoi(argv[++i]);
+        } else if (arg == "--trajectory" && hasValue) {
+            options.trajectoryFile = argv[++i];
+        } else if (arg == "--load" && hasValue) {
+            options.loadFile = argv[++i];
+        } else if (arg == "--checkpoint" && hasValue) {
+            options.checkpointFile = argv[++i];
+        } else if (arg == "--checkpoint-every" && hasValue) {
+            options.checkpointEvery = std::atoi(argv[++i]);
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--render-final") {
+            options.renderFinal = true;
+        } else if (arg == "--live") {
+            options.live = true;
+        } else if (arg == "--optimal") {
+            options.optimal = true;
+        } else if (arg.compare(0, 2, "--") != 0) {
+            options.fileName = arg;
+        } else {
+            std::cerr << "Error: Unknown or incomplete option " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (options.episodes < 1 || options.maxSteps < 1 || options.seeds < 1 || options.planningQueue < 1 ||
+        options.traceCapacity < 1) {
+        std::cerr << "Error: --episodes, --max-steps, --seeds, --planning-queue and --trace-capacity must be positive." << std::endl;
+        return false;
+    }
+    if (options.lambda < 0.0 || options.lambda > 1.0) {
+        std::cerr << "Error: --lambda must be between 0 and 1." << std::endl;
+        return false;
+    }
+    if (options.renderEvery < 0 || options.threads < 0 || options.convergenceWindow < 0 || options.evaluateAgents < 0 ||
+        options.checkpointEvery < 0 || options.planningSteps < 0) {
+        std::cerr << "Error: --render-every, --threads, --convergence-window, --evaluate, --checkpoint-every"
+                  << " and --planning-steps must not be negative." << std::endl;
+        return false;
+    }
+    if ((!options.trajectoryFile.empty() || !options.loadFile.empty() || !options.checkpointFile.empty() || options.live) &&
+        options.seeds > 1) {
+        std::cerr << "Error: --trajectory, --load, --checkpoint and --live apply to a single agent and cannot be combined with --seeds." << std::endl;
+        return false;
+    }
+    if (options.checkpointEvery > 0 && options.checkpointFile.empty()) {
+        std::cerr << "Error: --checkpoint-every needs --checkpoint." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void printTrainingUsage(const char* programName) {
+    std::cerr << "Usage: " << programName << " [maze file] [--episodes N] [--max-steps N]"
+              << " [--headless] [--render-every N] [--render-final] [--live] [--optimal]"
+              << " [--seed S] [--seeds N] [--threads N] [--convergence-window N]"
+              << " [--learning-rate A] [--discount G] [--exploration E]"
+              << " [--policy epsilon|softmax|ucb] [--decay constant|linear|exponential]"
+              << " [--exploration-min E] [--decay-episodes N] [--planning-steps K] [--planning-queue N]"
+              << " [--lambda L] [--trace-capacity N] [--evaluate N]"
+              << " [--trajectory FILE] [--load FILE] [--checkpoint FILE] [--checkpoint-every N]" << std::endl;
+}
+
+// Function to write the moves of the episode and the closing summary.
+static void printGoalReached(const Agent& agent, int steps, BufferedWriter& out) {
+    out << "Goal reached in " << steps << " steps!\n";
+    agent.moveHistory.printRuns(out);
+    out << "Position changed " << agent.positionChangeCount << " times.\n";
+}
+
+// Function to draw the maze after a step on the live view, with the step in the status line.
+static void drawStep(const MazeGrid& maze, const Agent& agent, int steps, TerminalRenderer& live) {
+    char status[96];
+    std::snprintf(status, sizeof(status), "Step %d: Position (%d, %d)", steps, agent.position.x, agent.position.y);
+    drawMaze(maze, agent, live);
+    live.setStatus(status);
+    live.present();
+}
+
+EpisodeResult runEpisode(Agent& agent, MazeGrid& maze, int maxSteps, BufferedWriter* renderer,
+                         TrajectoryWriter* trajectory, TerminalRenderer* live, bool learn) {
+    auto startTime = std::chrono::steady_clock::now();
+    EpisodeResult result = {0, false, 0.0};
+    int steps = 0;
+    agent.traces.clear(); // Traces do not carry over from the previous episode
+
+    // Perform the first move of the agent
+    moveAgent(agent, maze);
+    agent.moveHistory.push(2);
+    if (trajectory) {
+        trajectory->record(agent, 0, 2, 0, EMPTY);
+    }
+    steps++; // The opening move counts as a step, step 0 of the trajectory
+
+    // Print the initial state of the maze with the agent's position
+    if (renderer) {
+        printMaze(maze, agent, *renderer);
+    }
+    if (live) {
+        drawStep(maze, agent, steps, *live);
+    }
+
+    // Main game loop to iterate through the steps of the agent
+    while (steps < maxSteps) {
+        // Output the current step and agent's position
+        if (renderer) {
+            *renderer << "Step " << steps << ": Position (" << agent.position.x << ", " << agent.position.y << ")\n";
+        }
+
+        // Check if the agent has reached the goal
+        if (maze[agent.position.x][agent.position.y] == GOAL) {
+            result.reachedGoal = true;
+            break;
+        }
+
+        // Decide the next action for the agent based on its current state and the maze
+        int action = decideNextAction(agent, maze);
+
+        // Update the agent's previous position
+        agent.previousPosition = agent.position;
+
+        // Perform actions based on the chosen action
+        if (action == 2) { // Forward
+            moveAgent(agent, maze);
+            agent.lastAction = 2;
+            agent.moveHistory.push(2);
+        } else if (action == 3) { // Turn right then forward
+            turnAgent(agent, 3); // Right turn
+            moveAgent(agent, maze);
+            agent.lastAction = 2;
+            agent.moveHistory.push(3);
+        } else if (action == 1) { // Turn left then forward
+            turnAgent(agent, 1); // Left turn
+            moveAgent(agent, maze);
+            agent.lastAction = 1;
+            agent.moveHistory.push(1);
+        }
+
+        // Update the agent's state based on its new position, remembering the cell entered
+        // since an item on it is taken
+        int enteredCell = maze[agent.position.x][agent.position.y];
+        updateAgentState(agent, maze);
+        steps++;
+        // Print the maze after each move
+        if (renderer) {
+            printMaze(maze, agent, *renderer);
+            *renderer << "-------------------------------------\n";
+        }
+        if (live) {
+            drawStep(maze, agent, steps, *live);
+        }
+
+        // Update Q-values based on the agent's actions and rewards
+        int actionIndex = std::find(agent.actionList.begin(), agent.actionList.end(), action) - agent.actionList.begin();
+
+        // Reward of the cell entered, from the cell table
+        double reward = cellReward(enteredCell);
+
+        if (trajectory) {
+            trajectory->record(agent, steps - 1, action, static_cast<int>(reward), isConsumable(enteredCell) ? enteredCell : EMPTY);
+        }
+
+        if (learn) {
+            // Find the maximum Q-value for the new state
+            double maxQValue = agent.qTable.maxValue(agent.position.x, agent.position.y);
+
+            // Update the Q-table
+            double& qValue = agent.qTable.at(agent.previousPosition.x, agent.previousPosition.y, actionIndex);
+            if (agent.traces.enabled()) {
+                // Q(lambda): the TD error also reaches the recently taken pairs, along their traces
+                bool greedy = qValue >= agent.qTable.maxValue(agent.previousPosition.x, agent.previousPosition.y);
+                agent.traces.update(agent.qTable.data(), &qValue - agent.qTable.data(),
+                                    reward + agent.discountFactor * maxQValue - qValue, agent.learningRate,
+                                    agent.discountFactor, greedy);
+            } else {
+                qValue += agent.learningRate * (reward + agent.discountFactor * maxQValue - qValue);
+            }
+
+            // Dyna-Q: learn the move into the model and replay the moves it makes out of date
+            if (agent.planner.enabled()) {
+                agent.planner.update(agent.qTable.data(),
+                                     static_cast<std::size_t>(agent.previousPosition.x) * maze.cols + agent.previousPosition.y,
+                                     actionIndex, static_cast<std::size_t>(agent.position.x) * maze.cols + agent.position.y,
+                                     static_cast<int>(reward), agent.learningRate, agent.discountFactor);
+            }
+        }
+
+        // Check if goal is reached
+        if (maze[agent.position.x][agent.position.y] == GOAL) {
+            result.reachedGoal = true;
+            break;
+        }
+    }
+
+    if (renderer) {
+        if (result.reachedGoal) {
+            printGoalReached(agent, steps, *renderer);
+        } else {
+            *renderer << "Maximum steps reached. Exiting loop.\n";
+        }
+    }
+    if (live) {
+        char status[64];
+        std::snprintf(status, sizeof(status), result.reachedGoal ? "Goal reached in %d steps!" : "Maximum steps (%d) reached.", steps);
+        live->setStatus(status);
+        live->present();
+    }
+
+    result.steps = steps;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+void applyTrainingOptions(Agent& agent, const TrainingOptions& options) {
+    if (options.learningRate >= 0.0) {
+        agent.learningRate = options.learningRate;
+    }
+    if (options.discountFactor >= 0.0) {
+        agent.discountFactor = options.discountFactor;
+    }
+    if (options.explorationRate >= 0.0) {
+        agent.policy.start = options.explorationRate;
+    }
+    if (options.policy >= 0) {
+        agent.policy.strategy = static_cast<ExplorationStrategy>(options.policy);
+    }
+    if (options.decay >= 0) {
+        agent.policy.decay = static_cast<DecaySchedule>(options.decay);
+    }
+    if (options.explorationMin >= 0.0) {
+        agent.policy.minimum = options.explorationMin;
+    }
+    if (options.decayEpisodes >= 0) {
+        agent.policy.decayEpisodes = options.decayEpisodes;
+    }
+    agent.explorationRate = agent.policy.parameter(agent.episodesTrained);
+    if (options.planningSteps > 0) {
+        agent.planner.resize(agent.qTable.getRows(), agent.qTable.getCols(), agent.qTable.getActions(), MAX_STEP_SIZE,
+                             options.planningSteps, static_cast<std::size_t>(options.planningQueue));
+    }
+    if (options.lambda > 0.0) {
+        agent.traces.configure(options.lambda, static_cast<std::size_t>(options.traceCapacity));
+    }
+}
+
+int greedyPathLength(const Agent& agent, MazeGrid& maze, int maxSteps) {
+    // Walk a separate agent over the maze as loaded, so the trained one keeps its state.
+    maze.restoreItems();
+    Agent walker;
+    resetAgent(walker, maze);
+
+    // Start with the same forward move as runEpisode
+    moveAgent(walker, maze);
+    int steps = 1;
+    bool reachedGoal = false;
+    while (steps < maxSteps) {
+        // Take the action with the highest Q-value: 1 - Turn Left, 2 - Forward, 3 - Turn Right, each then forward
+        int action = agent.actionList[agent.qTable.bestAction(walker.position.x, walker.position.y)];
+        if (action != 2) {
+            turnAgent(walker, action);
+        }
+        moveAgent(walker, maze);
+        updateAgentState(walker, maze);
+        steps++;
+
+        if (maze[walker.position.x][walker.position.y] == GOAL) {
+            reachedGoal = true;
+            break;
+        }
+    }
+
+    maze.restoreItems();
+    return reachedGoal ? steps : -1;
+}
+
+// Function to fill a checkpoint header for the agent's Q-table on the maze.
+static QCheckpointHeader agentCheckpointHeader(const Agent& agent, std::uint64_t mazeHash) {
+    QCheckpointHeader header = makeQCheckpointHeader();
+    header.mazeHash = mazeHash;
+    header.rows = static_cast<std::uint32_t>(agent.qTable.getRows());
+    header.cols = static_cast<std::uint32_t>(agent.qTable.getCols());
+    header.actions = static_cast<std::uint32_t>(agent.qTable.getActions());
+    header.valueSize = sizeof(double);
+    header.learningRate = agent.learningRate;
+    header.discountFactor = agent.discountFactor;
+    header.explorationRate = agent.policy.start; // The schedule restarts from it, at the episodes trained
+    header.explorationStrategy = static_cast<std::uint32_t>(agent.policy.strategy);
+    header.decaySchedule = static_cast<std::uint32_t>(agent.policy.decay);
+    header.explorationMin = agent.policy.minimum;
+    header.decayEpisodes = static_cast<std::uint32_t>(agent.policy.decayEpisodes);
+    header.episodes = static_cast<std::uint64_t>(agent.episodesTrained);
+    return header;
+}
+
+bool saveAgentCheckpoint(const std::string& fileName, const Agent& agent, const MazeGrid& maze) {
+    return writeQCheckpoint(fileName, agentCheckpointHeader(agent, maze.hash()), agent.qTable.data());
+}
+
+bool loadAgentCheckpoint(const std::string& fileName, Agent& agent, const MazeGrid& maze) {
+    QCheckpointHeader header;
+    void* values = nullptr;
+    std::shared_ptr<void> mapping = mapQCheckpoint(fileName, header, values);
+    if (!mapping) {
+        return false;
+    }
+    if (header.mazeHash != maze.hash() || header.rows != static_cast<std::uint32_t>(maze.rows) ||
+        header.cols != static_cast<std::uint32_t>(maze.cols)) {
+        std::cerr << "Error: Checkpoint " << fileName << " was not made on this maze." << std::endl;
+        return false;
+    }
+    if (header.actions != agent.actionList.size() || header.valueSize != sizeof(double)) {
+        std::cerr << "Error: Checkpoint " << fileName << " has " << header.actions << " actions of "
+                  << header.valueSize << " bytes, expected " << agent.actionList.size() << " of "
+                  << sizeof(double) << "." << std::endl;
+        return false;
+    }
+
+    if (header.explorationStrategy > UCB || header.decaySchedule > DECAY_EXPONENTIAL) {
+        std::cerr << "Error: Checkpoint " << fileName << " has an unknown exploration policy." << std::endl;
+        return false;
+    }
+
+    agent.qTable.attach(maze.rows, maze.cols, static_cast<int>(header.actions), static_cast<double*>(values), mapping);
+    agent.learningRate = header.learningRate;
+    agent.discountFactor = header.discountFactor;
+    agent.policy.strategy = static_cast<ExplorationStrategy>(header.explorationStrategy);
+    agent.policy.decay = static_cast<DecaySchedule>(header.decaySchedule);
+    agent.policy.start = header.explorationRate;
+    agent.policy.minimum = header.explorationMin;
+    agent.policy.decayEpisodes = static_cast<int>(header.decayEpisodes);
+    agent.episodesTrained = static_cast<int>(header.episodes);
+    agent.explorationRate = agent.policy.parameter(agent.episodesTrained);
+    return true;
+}
+
+TrainingSummary trainAgent(Agent& agent, MazeGrid& maze, const TrainingOptions& options, BufferedWriter* out,
+                           TrajectoryWriter* trajectory) {
+    TrainingSummary summary = {0, 0, 0, 0, 0.0, -1, -1};
+
+    // A greedy walk longer than the number of (cell, direction, stepSize) states is going in circles.
+    int greedyMaxSteps = std::min(options.maxSteps, maze.rows * maze.cols * 4 * 3);
+    int previousPathLength = -1;
+    int unchangedEpisodes = 0;
+
+    // Rendered episodes are drawn in place when live, after any text already written.
+    // Without out nothing is rendered, so the terminal is left alone.
+    std::unique_ptr<TerminalRenderer> screen;
+    if (options.live && out) {
+        screen.reset(new TerminalRenderer(maze.rows, maze.cols));
+        out->flush();
+    }
+
+    // Periodic checkpoints are written in the background while training goes on.
+    QCheckpointWriter checkpoints;
+    std::uint64_t mazeHash = 0;
+    if (options.checkpointEvery > 0) {
+        maze.restoreItems();
+        mazeHash = maze.hash();
+    }
+
+    for (int episode = 1; episode <= options.episodes; ++episode) {
+        // Start every episode from the maze as loaded and the agent on START
+        maze.restoreItems();
+        resetAgent(agent, maze);
+        agent.explorationRate = agent.policy.parameter(agent.episodesTrained);
+
+        // Render every step unless headless; headless runs render only the requested episodes
+        bool render = out && (!options.headless || (options.renderEvery > 0 && episode % options.renderEvery == 0));
+        if (trajectory) {
+            trajectory->beginEpisode(episode);
+        }
+        EpisodeResult result = runEpisode(agent, maze, options.maxSteps, render && !screen ? out : nullptr, trajectory,
+                                          render ? screen.get() : nullptr);
+
+        summary.episodes++;
+        summary.goalsReached += result.reachedGoal ? 1 : 0;
+        summary.totalSteps += result.steps;
+        summary.lastEpisodeSteps = result.steps;
+        summary.seconds += result.seconds;
+        agent.episodesTrained++;
+
+        if (options.checkpointEvery > 0 && episode % options.checkpointEvery == 0) {
+            checkpoints.writeAsync(options.checkpointFile, agentCheckpointHeader(agent, mazeHash), agent.qTable.data());
+        }
+
+        // The run has converged once the greedy path to the goal stops changing for a whole window.
+        if (options.convergenceWindow > 0 && summary.convergedEpisode < 0) {
+            int pathLength = greedyPathLength(agent, maze, greedyMaxSteps);
+            unchangedEpisodes = (pathLength > 0 && pathLength == previousPathLength) ? unchangedEpisodes + 1 : 0;
+            previousPathLength = pathLength;
+            if (unchangedEpisodes + 1 >= options.convergenceWindow && pathLength > 0) {
+                summary.convergedEpisode = episode - unchangedEpisodes;
+            }
+        }
+
+        if (out && !screen) {
+            *out << "Episode " << episode << ": " << (result.reachedGoal ? "goal reached" : "goal not reached")
+                 << " in " << result.steps << " steps, " << result.seconds * 1000.0 << " ms\n";
+        }
+    }
+
+    if (screen) {
+        screen->release();
+    }
+    maze.restoreItems();
+    summary.greedyPathLength = greedyPathLength(agent, maze, greedyMaxSteps);
+    if (!checkpoints.wait()) {
+        std::cerr << "Error: Failed to write checkpoint " << options.checkpointFile << std::endl;
+    }
+    return summary;
+}
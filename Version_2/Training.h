@@ -0,0 +1,109 @@
+#ifndef TRAINING_H
+#define TRAINING_H
+
+#include <string>
+#include <cstdint>
+
+#include "Agent.h"
+#include "MazeGrid.h"
+#include "BufferedWriter.h"
+#include "TrajectoryLog.h"
+#include "TerminalRenderer.h"
+
+// Options controlling a training run, read from the command line.
+struct TrainingOptions {
+    std::string fileName = "maze.txt"; // Maze file to load, text or binary
+    int episodes = 1; // Number of training episodes
+    int maxSteps = 20000; // Maximum number of steps per episode
+    bool headless = false; // Render nothing unless requested below
+    int renderEvery = 0; // Render every Nth episode in headless mode, 0 for never
+    bool renderFinal = false; // Render a greedy rollout after training
+    bool live = false; // Draw rendered episodes in place in the terminal instead of as a text log
+    bool optimal = false; // Report the shortest route found by the solver for comparison
+    std::uint64_t seed = 1; // Seed of the agent's random number generator
+    int seeds = 1; // Number of independent agents to train, seeded seed, seed + 1, ...
+    int threads = 0; // Worker threads for multi-seed training, 0 for one per core
+    int convergenceWindow = 0; // Episodes the greedy path must stay unchanged to count as converged, 0 to skip the check
+    double learningRate = -1.0; // Overrides the agent's learning rate when not negative
+    double discountFactor = -1.0; // Overrides the agent's discount factor when not negative
+    double explorationRate = -1.0; // Overrides the agent's exploration rate when not negative
+    int policy = -1; // Overrides the agent's ExplorationStrategy when not negative
+    int decay = -1; // Overrides the agent's DecaySchedule of the exploration rate when not negative
+    double explorationMin = -1.0; // Overrides the exploration rate the decay ends at when not negative
+    int decayEpisodes = -1; // Overrides the length of the decay in episodes when not negative
+    int planningSteps = 0; // Dyna-Q updates replayed from the learned model after each step, 0 for none
+    int planningQueue = 4096; // Pairs kept in the prioritized sweeping queue
+    double lambda = 0.0; // Trace decay of Watkins Q(lambda), 0 for one-step Q-learning
+    int traceCapacity = 64; // Most eligibility traces kept at once
+    int evaluateAgents = 0; // Agents run in one batch with the trained policy after training, 0 to skip
+    std::string trajectoryFile; // File the steps of every episode are logged to, empty for none
+    std::string loadFile; // Q-table checkpoint to start from, empty to start from zero
+    std::string checkpointFile; // File the Q-table is saved to after training, empty for none
+    int checkpointEvery = 0; // Also save the Q-table every Nth episode, 0 for only after training
+};
+
+// Result of running one episode.
+struct EpisodeResult {
+    int steps; // Steps taken in the episode
+    bool reachedGoal; // Whether the agent reached the GOAL cell
+    double seconds; // Wall-clock time of the episode
+};
+
+// Summary of a multi-episode training run.
+struct TrainingSummary {
+    int episodes; // Episodes run
+    int goalsReached; // Episodes that ended on the GOAL cell
+    long long totalSteps; // Steps summed over all episodes
+    int lastEpisodeSteps; // Steps taken in the final episode
+    double seconds; // Wall-clock time summed over all episodes
+    int convergedEpisode; // First episode of the unchanged greedy run, -1 if not converged or not checked
+    int greedyPathLength; // Steps of the greedy policy to the goal after training, -1 if it does not reach it
+};
+
+// Function to read training options from the command line. Returns false on invalid arguments.
+bool parseTrainingOptions(int argc, char* argv[], TrainingOptions& options);
+
+// Function to print the command line usage.
+void printTrainingUsage(const char* programName);
+
+// Function to run one episode of Q-learning from the agent's current state.
+// When renderer is not null, every step and the maze after it are written to it.
+// When trajectory is not null, every step is logged to it.
+// When live is not null, every step is drawn on it as a frame of a live terminal view.
+// When learn is false the Q-table, traces and planner are left as they are.
+EpisodeResult runEpisode(Agent& agent, MazeGrid& maze, int maxSteps, BufferedWriter* renderer,
+                         TrajectoryWriter* trajectory = nullptr, TerminalRenderer* live = nullptr, bool learn = true);
+
+// Function to apply the hyperparameter overrides, the exploration policy, Dyna-Q planning and
+// eligibility traces from the options to the agent. The exploration rate becomes the start of
+// the policy's schedule.
+void applyTrainingOptions(Agent& agent, const TrainingOptions& options);
+
+// Function to count the steps the greedy policy of the agent needs to reach the goal,
+// without learning or moving the agent. Returns -1 if it does not reach it within maxSteps.
+int greedyPathLength(const Agent& agent, MazeGrid& maze, int maxSteps);
+
+// Function to save the agent's Q-table and hyperparameters to a checkpoint file.
+// The maze must be as loaded, with no items taken. Returns false on failure.
+bool saveAgentCheckpoint(const std::string& fileName, const Agent& agent, const MazeGrid& maze);
+
+// Function to load a checkpoint into the agent. The Q-table is memory-mapped rather than
+// read, so even a large table is ready at once. Fails if the checkpoint was made on another
+// maze or with another action set. The exploration policy is restored with the table, and
+// options given on the command line override it. The maze must be as loaded, with no items taken.
+bool loadAgentCheckpoint(const std::string& fileName, Agent& agent, const MazeGrid& maze);
+
+// Function to train the agent for options.episodes episodes on one maze, keeping its QTable.
+// Items taken in an episode are put back before the next one with maze.restoreItems().
+// The exploration rate of each episode follows agent.policy, counting agent.episodesTrained.
+// When out is not null, a line per episode and the requested renders are written to it.
+// With options.live and out set, the renders are drawn in place in the terminal and the episode
+// lines are left out.
+// When trajectory is not null, the steps of every episode are logged to it.
+// With options.checkpointEvery set, the Q-table is saved to options.checkpointFile in the
+// background every that many episodes; a checkpoint is skipped if the previous one is still
+// being written.
+TrainingSummary trainAgent(Agent& agent, MazeGrid& maze, const TrainingOptions& options, BufferedWriter* out,
+                           TrajectoryWriter* trajectory = nullptr);
+
+#endif // TRAINING_H
@@ -0,0 +1,204 @@
+#include "TrajectoryLog.h"
+
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+#include "MazeElements.h"
+
+TrajectoryWriter::TrajectoryWriter(std::size_t bufferRecords)
+    : file(nullptr), capacity(bufferRecords > 0 ? bufferRecords : 1), currentEpisode(1),
+      pending(false), stopping(false), failed(false) {}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    close();
+}
+
+bool TrajectoryWriter::open(const std::string& fileName, const MazeGrid& maze) {
+    close();
+
+    file = std::fopen(fileName.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "Failed to open file: " << fileName << std::endl;
+        return false;
+    }
+
+    TrajectoryFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TRAJECTORY_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRAJECTORY_FILE_VERSION;
+    header.rows = static_cast<std::uint32_t>(maze.rows);
+    header.cols = static_cast<std::uint32_t>(maze.cols);
+    header.mazeHash = maze.hash();
+    header.recordSize = sizeof(TrajectoryRecord);
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        std::cerr << "Failed to write file: " << fileName << std::endl;
+        std::fclose(file);
+        file = nullptr;
+        return false;
+    }
+
+    filling.clear();
+    filling.reserve(capacity);
+    writing.clear();
+    writing.reserve(capacity);
+    currentEpisode = 1;
+    pending = false;
+    stopping = false;
+    failed = false;
+    writer = std::thread(&TrajectoryWriter::writeLoop, this);
+    return true;
+}
+
+bool TrajectoryWriter::close() {
+    if (file == nullptr) {
+        return true;
+    }
+    if (!filling.empty()) {
+        handOff();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+
+    bool ok = !failed && std::fclose(file) == 0;
+    file = nullptr;
+    return ok;
+}
+
+void TrajectoryWriter::handOff() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return !pending; });
+    filling.swap(writing); // writing was emptied by the thread, so filling starts empty
+    pending = true;
+    lock.unlock();
+    changed.notify_all();
+}
+
+void TrajectoryWriter::writeLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [this] { return pending || stopping; });
+        if (!pending) {
+            return; // Stopping with nothing left to write
+        }
+
+        // The records are not touched by the training thread while pending is set.
+        lock.unlock();
+        bool ok = std::fwrite(writing.data(), sizeof(TrajectoryRecord), writing.size(), file) == writing.size();
+        writing.clear();
+        lock.lock();
+
+        failed = failed || !ok;
+        pending = false;
+        changed.notify_all();
+    }
+}
+
+bool TrajectoryReader::open(const std::string& fileName) {
+    file.close();
+    file.clear();
+    recordCount = 0;
+
+    file.open(fileName, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << fileName << std::endl;
+        return false;
+    }
+    std::uint64_t fileSize = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0);
+    if (fileSize < sizeof(fileHeader) ||
+        !file.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader)) ||
+        std::memcmp(fileHeader.magic, TRAJECTORY_FILE_MAGIC, sizeof(TRAJECTORY_FILE_MAGIC)) != 0 ||
+        fileHeader.version != TRAJECTORY_FILE_VERSION ||
+        fileHeader.recordSize != sizeof(TrajectoryRecord)) {
+        std::cerr << "Error: " << fileName << " is not a valid trajectory file." << std::endl;
+        file.close();
+        return false;
+    }
+
+    // A log cut short by a crash may end in a partial record; it is ignored.
+    recordCount = (fileSize - sizeof(fileHeader)) / sizeof(TrajectoryRecord);
+    return true;
+}
+
+bool TrajectoryReader::read(std::uint64_t index, std::uint64_t count, std::vector<TrajectoryRecord>& records) {
+    if (index > recordCount || count > recordCount - index) {
+        return false;
+    }
+    records.resize(static_cast<std::size_t>(count));
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(sizeof(fileHeader) + index * sizeof(TrajectoryRecord)));
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(records.data()),
+                                       static_cast<std::streamsize>(count * sizeof(TrajectoryRecord))));
+}
+
+std::uint64_t TrajectoryReader::findEpisode(int episode) {
+    // Episodes are logged in increasing order, so the first record is found by binary search.
+    std::vector<TrajectoryRecord> record;
+    std::uint64_t low = 0;
+    std::uint64_t high = recordCount;
+    while (low < high) {
+        std::uint64_t middle = low + (high - low) / 2;
+        if (!read(middle, 1, record)) {
+            return recordCount;
+        }
+        if (record[0].episode < static_cast<std::uint32_t>(episode)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == recordCount || !read(low, 1, record) || record[0].episode != static_cast<std::uint32_t>(episode)) {
+        return recordCount;
+    }
+    return low;
+}
+
+bool replayTrajectory(TrajectoryReader& reader, MazeGrid& maze, int episode, int step, Agent& agent,
+                      TrajectoryRecord& record) {
+    maze.restoreItems();
+    std::uint64_t index = reader.findEpisode(episode);
+    if (index == reader.size() || step < 0) {
+        return false;
+    }
+
+    // Walk the episode up to the step, taking the items it took.
+    const std::uint64_t chunk = 4096;
+    std::vector<TrajectoryRecord> records;
+    bool found = false;
+    bool done = false;
+    while (!done && index < reader.size()) {
+        std::uint64_t count = std::min(chunk, reader.size() - index);
+        if (!reader.read(index, count, records)) {
+            return false;
+        }
+        for (const TrajectoryRecord& entry : records) {
+            if (entry.episode != static_cast<std::uint32_t>(episode) || entry.step > static_cast<std::uint32_t>(step)) {
+                done = true;
+                break;
+            }
+            if (entry.itemTaken != EMPTY && maze.inBounds(entry.row, entry.col)) {
+                maze.consume(maze.index(entry.row, entry.col));
+            }
+            record = entry;
+            found = entry.step == static_cast<std::uint32_t>(step);
+        }
+        index += count;
+    }
+    if (!found) {
+        return false;
+    }
+
+    agent.position.x = record.row;
+    agent.position.y = record.col;
+    agent.previousPosition = agent.position;
+    agent.direction = static_cast<Direction>(record.direction & 0x03);
+    agent.stepSize = record.stepSize;
+    agent.perceptField = record.perceptField;
+    agent.lastAction = record.action;
+    return true;
+}
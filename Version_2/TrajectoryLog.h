@@ -0,0 +1,143 @@
+#ifndef TRAJECTORYLOG_H
+#define TRAJECTORYLOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+
+#include "Agent.h"
+#include "MazeGrid.h"
+
+// Trajectory file (.mzt) layout:
+//   TrajectoryFileHeader, followed by one TrajectoryRecord per step, in the order taken.
+// Records have a fixed size, so step n of a file is found by seeking, without parsing.
+// Fields are stored in native (little-endian) byte order.
+const char TRAJECTORY_FILE_MAGIC[4] = {'M', 'Z', 'T', 'R'};
+const std::uint32_t TRAJECTORY_FILE_VERSION = 1;
+
+struct TrajectoryFileHeader {
+    char magic[4];              // Always TRAJECTORY_FILE_MAGIC
+    std::uint32_t version;      // Format version, TRAJECTORY_FILE_VERSION
+    std::uint32_t rows;         // Number of rows in the maze
+    std::uint32_t cols;         // Number of columns in the maze
+    std::uint64_t mazeHash;     // MazeGrid::hash() of the maze the agent ran on
+    std::uint32_t recordSize;   // sizeof(TrajectoryRecord)
+    std::uint32_t reserved;     // Zero
+};
+
+// State of the agent after one step.
+struct TrajectoryRecord {
+    std::uint32_t episode;      // Episode number, counting from 1
+    std::uint32_t step;         // Step number within the episode, 0 for the opening forward move
+    std::int32_t row;           // Row of the agent after the step
+    std::int32_t col;           // Column of the agent after the step
+    std::int16_t reward;        // Reward given for the step, 0 for the opening move
+    std::uint8_t direction;     // Direction after the step (NORTH, EAST, SOUTH, WEST)
+    std::uint8_t action;        // Action taken: 1 - Turn Left, 2 - Forward, 3 - Turn Right, each then forward
+    std::uint8_t stepSize;      // stepSize after the step
+    std::uint8_t perceptField;  // perceptField after the step
+    std::uint8_t itemTaken;     // Cell code of the item taken from the maze on the step, EMPTY if none
+    std::uint8_t reserved;      // Zero
+};
+
+static_assert(sizeof(TrajectoryFileHeader) == 32, "Trajectory file header must stay 32 bytes");
+static_assert(sizeof(TrajectoryRecord) == 24, "Trajectory records must stay 24 bytes");
+
+// Writes trajectory records to a file from a background thread.
+// Records are collected in one buffer while the thread writes the other, so logging a step
+// costs a copy into memory. Training waits only if a whole buffer fills before the previous
+// one is written.
+class TrajectoryWriter {
+public:
+    explicit TrajectoryWriter(std::size_t bufferRecords = 1 << 15);
+    ~TrajectoryWriter();
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+    // Create the file, write its header and start the writer thread. Returns false on failure.
+    bool open(const std::string& fileName, const MazeGrid& maze);
+
+    // Write the remaining records, stop the thread and close the file.
+    // Returns false if any write failed.
+    bool close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Set the episode number stamped on the following records.
+    void beginEpisode(int episode) { currentEpisode = static_cast<std::uint32_t>(episode); }
+
+    // Log the agent's state after a step.
+    void record(const Agent& agent, int step, int action, int reward, int itemTaken) {
+        TrajectoryRecord entry;
+        entry.episode = currentEpisode;
+        entry.step = static_cast<std::uint32_t>(step);
+        entry.row = agent.position.x;
+        entry.col = agent.position.y;
+        entry.reward = static_cast<std::int16_t>(reward);
+        entry.direction = static_cast<std::uint8_t>(agent.direction);
+        entry.action = static_cast<std::uint8_t>(action);
+        entry.stepSize = static_cast<std::uint8_t>(agent.stepSize);
+        entry.perceptField = static_cast<std::uint8_t>(agent.perceptField);
+        entry.itemTaken = static_cast<std::uint8_t>(itemTaken);
+        entry.reserved = 0;
+        filling.push_back(entry);
+        if (filling.size() >= capacity) {
+            handOff();
+        }
+    }
+
+private:
+    // Give the full buffer to the writer thread, waiting for it to finish the previous one.
+    void handOff();
+
+    // Body of the writer thread.
+    void writeLoop();
+
+    std::FILE* file; // Destination of the records
+    std::size_t capacity; // Records per buffer
+    std::uint32_t currentEpisode; // Episode stamped on new records
+    std::vector<TrajectoryRecord> filling; // Records being collected
+    std::vector<TrajectoryRecord> writing; // Records owned by the writer thread while pending
+    std::thread writer; // Background thread writing the records
+    std::mutex mutex; // Guards pending, stopping and failed
+    std::condition_variable changed; // Signalled when pending or stopping changes
+    bool pending; // Whether writing holds records not yet written
+    bool stopping; // Whether the thread should exit once nothing is pending
+    bool failed; // Whether a write failed
+};
+
+// Read access to a trajectory file. Records are read on demand, so large logs are never
+// loaded whole.
+class TrajectoryReader {
+public:
+    // Open the file and validate its header. Returns false if the file cannot be used.
+    bool open(const std::string& fileName);
+
+    const TrajectoryFileHeader& header() const { return fileHeader; }
+
+    // Number of records in the file.
+    std::uint64_t size() const { return recordCount; }
+
+    // Read count records starting at index into records. Returns false if they are not all in the file.
+    bool read(std::uint64_t index, std::uint64_t count, std::vector<TrajectoryRecord>& records);
+
+    // Index of the first record of an episode, or size() if the file has none.
+    std::uint64_t findEpisode(int episode);
+
+private:
+    std::ifstream file; // The trajectory file
+    TrajectoryFileHeader fileHeader; // Header read from the file
+    std::uint64_t recordCount = 0; // Number of complete records in the file
+};
+
+// Function to rebuild the maze and agent as they were after a step of an episode, by
+// taking the items the log records up to that step from the maze as loaded.
+// The step's record is copied to record. Returns false if the log has no such step.
+bool replayTrajectory(TrajectoryReader& reader, MazeGrid& maze, int episode, int step, Agent& agent,
+                      TrajectoryRecord& record);
+
+#endif // TRAJECTORYLOG_H
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "../QTable.cpp"
+#include "../BufferedWriter.cpp"
+#include "../MazeBinary.cpp"
+#include "../MazeUtils.cpp"
+#include "../AgentUtils.cpp"
+#include "../TrajectoryLog.cpp"
+
+// Replays a trajectory logged with main --trajectory, rendering the maze as it was after a step.
+// Usage: trajectory_replay <maze file> <trajectory file> [episode [step]]
+// Without an episode the episodes in the log are listed. Without a step every step of the
+// episode is rendered.
+
+// Function to write the step line and the maze after a step, as runEpisode renders it.
+static void renderStep(const MazeGrid& maze, const Agent& agent, const TrajectoryRecord& record, BufferedWriter& out) {
+    out << "Episode " << static_cast<int>(record.episode) << ", step " << static_cast<int>(record.step)
+        << ": " << moveName(record.action) << ", position (" << record.row << ", " << record.col
+        << "), reward " << static_cast<int>(record.reward) << ", stepSize " << static_cast<int>(record.stepSize)
+        << ", perceptField " << static_cast<int>(record.perceptField) << '\n';
+    printMaze(maze, agent, out);
+    out << "-------------------------------------\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 5) {
+        std::cerr << "Usage: " << argv[0] << " <maze file> <trajectory file> [episode [step]]" << std::endl;
+        return 1;
+    }
+
+    auto maze = readMaze(argv[1]);
+    if (maze.empty()) {
+        std::cerr << "Error: Failed to load maze " << argv[1] << std::endl;
+        return 1;
+    }
+    TrajectoryReader reader;
+    if (!reader.open(argv[2])) {
+        return 1;
+    }
+    if (reader.header().rows != static_cast<std::uint32_t>(maze.rows) ||
+        reader.header().cols != static_cast<std::uint32_t>(maze.cols) ||
+        reader.header().mazeHash != maze.hash()) {
+        std::cerr << "Error: " << argv[2] << " was not logged on maze " << argv[1] << std::endl;
+        return 1;
+    }
+
+    BufferedWriter out(stdout);
+    std::vector<TrajectoryRecord> records;
+    const std::uint64_t chunk = 4096;
+
+    // List the episodes and their step counts
+    if (argc == 3) {
+        std::uint32_t episode = 0;
+        long long steps = 0;
+        for (std::uint64_t index = 0; index < reader.size(); index += chunk) {
+            if (!reader.read(index, std::min(chunk, reader.size() - index), records)) {
+                std::cerr << "Error: Failed to read " << argv[2] << std::endl;
+                return 1;
+            }
+            for (const TrajectoryRecord& record : records) {
+                if (record.episode != episode && steps > 0) {
+                    out << "Episode " << static_cast<int>(episode) << ": " << steps << " steps\n";
+                    steps = 0;
+                }
+                episode = record.episode;
+                steps++;
+            }
+        }
+        if (steps > 0) {
+            out << "Episode " << static_cast<int>(episode) << ": " << steps << " steps\n";
+        }
+        out << static_cast<long long>(reader.size()) << " steps logged\n";
+        return 0;
+    }
+
+    int episode = std::atoi(argv[3]);
+    Agent agent = initializeAgent(maze);
+
+    // Render a single step
+    if (argc == 5) {
+        int step = std::atoi(argv[4]);
+        TrajectoryRecord record;
+        if (!replayTrajectory(reader, maze, episode, step, agent, record)) {
+            std::cerr << "Error: Episode " << episode << " has no step " << step << std::endl;
+            return 1;
+        }
+        renderStep(maze, agent, record, out);
+        return 0;
+    }
+
+    // Render every step of the episode, taking items as the log records them
+    std::uint64_t index = reader.findEpisode(episode);
+    if (index == reader.size()) {
+        std::cerr << "Error: No episode " << episode << " in " << argv[2] << std::endl;
+        return 1;
+    }
+    for (bool done = false; !done && index < reader.size(); index += chunk) {
+        if (!reader.read(index, std::min(chunk, reader.size() - index), records)) {
+            std::cerr << "Error: Failed to read " << argv[2] << std::endl;
+            return 1;
+        }
+        for (const TrajectoryRecord& record : records) {
+            if (record.episode != static_cast<std::uint32_t>(episode)) {
+                done = true;
+                break;
+            }
+            if (record.itemTaken != EMPTY && maze.inBounds(record.row, record.col)) {
+                maze.consume(maze.index(record.row, record.col));
+            }
+            agent.position.x = record.row;
+            agent.position.y = record.col;
+            agent.direction = static_cast<Direction>(record.direction & 0x03);
+            agent.stepSize = record.stepSize;
+            agent.perceptField = record.perceptField;
+            renderStep(maze, agent, record, out);
+        }
+    }
+    return 0;
+}
@@ -13,134 +13,135 @@
 
 #include "AgentUtils.h"
 #include "Agent.h"
+#include "Training.h"
+#include "ParallelTraining.h"
+#include "Solver.h"
+#include "ItemPlanner.h"
+#include "AgentBatch.h"
+#include "TrajectoryLog.h"
+#include "QCheckpoint.h"
+#include "QTable.cpp"
+#include "BufferedWriter.cpp"
+#include "MazeBinary.cpp"
 #include "MazeUtils.cpp"
 #include "MazeUtils.h" // Include the fi le where GOAL is defined
 #include "AgentUtils.cpp"
+#include "Training.cpp"
+#include "ParallelTraining.cpp"
+#include "Solver.cpp"
+#include "ItemPlanner.cpp"
+#include "AgentBatch.cpp"
+#include "TrajectoryLog.cpp"
+#include "QCheckpoint.cpp"
 
 
 using namespace std;
 
-int main() {
-    // Set the maximum number of steps the agent can take
-    int maxSteps = 20000; 
-    std::string fileName = "maze.txt";
-    auto maze = readMaze(fileName);
+int main(int argc, char* argv[]) {
+    // Read the maze file and training options from the command line
+    TrainingOptions options;
+    if (!parseTrainingOptions(argc, argv, options)) {
+        printTrainingUsage(argv[0]);
+        return 1;
+    }
 
-    // Initialize the agent with its starting position and parameters
-    Agent agent = initializeAgent(maze); // Ensure this function returns an Agent type
-
-    int steps = 0;
-
-    // Perform the first move of the agent
-    moveAgent(agent, maze);
-    agent.moveHistory.push_back("Forward");
-    steps++;
-
-    // Print the initial state of the maze with the agent's position
-    printMaze(maze, agent);
-    
-    // Main game loop to iterate through the steps of the agent
-    while (steps < maxSteps) {
-        // Output the current step and agent's position
-        std::cout << "Step " << steps << ": Position (" << agent.position.x << ", " << agent.position.y << ")" << std::endl;
-
-        // Decide the next action for the agent based on its current state and the maze
-        int action = decideNextAction(agent, maze);
-    
-        // Update the agent's previous position
-        agent.previousPosition = agent.position;
-        
-        // Check if the maximum number of steps has been reached
-        if (steps >= maxSteps) {
-            std::cout << "Maximum steps reached. Exiting." << std::endl;
-            break;
-        }
+    auto maze = readMaze(options.fileName);
+    if (maze.empty()) {
+        std::cerr << "Error: Failed to load maze " << options.fileName << std::endl;
+        return 1;
+    }
 
-        // Check if the agent's current position is within maze boundaries and not a wall
-        if (agent.position.x >= 0 && agent.position.x < maze.size() &&
-            agent.position.y >= 0 && agent.position.y < maze[agent.position.x].size()) {
-
-            // Check if the agent has reached the goal
-            if (maze[agent.position.x][agent.position.y] == GOAL) {
-                // Output success message and the list of moves taken
-                std::cout << "Goal reached in " << steps << " steps!" << std::endl;
-                std::cout << "List of moves: ";
-                for (const auto& move : agent.moveHistory) {
-                    std::cout << move << "; ";
-                }
-                std::cout << std::endl;
-                std::cout << "Position changed " << agent.positionChangeCount << " times." << std::endl;
-                break; // Exit the loop since the goal is reached
-            }
-        } else {
-            // Handle the case where the agent is out of the maze bounds
-            std::cerr << "Error: Agent is out of bounds." << std::endl;
-            break; // Consider breaking the loop or resetting the agent's position
+    BufferedWriter out(stdout);
+
+    // Shortest route as a baseline for the learned ones
+    if (options.optimal) {
+        SolverResult optimal = solveMaze(maze);
+        out << "Shortest route: " << optimal.length << " steps\n";
+        ItemRoute itemRoute = planItemRoute(maze);
+        out << "Shortest route with consumed potions: " << itemRoute.length << " steps\n";
+    }
+
+    // Train several independently seeded agents in parallel and report each one
+    if (options.seeds > 1) {
+        std::vector<SeedResult> results = trainSeeds(maze, options);
+        out << "seed,episodes,goals_reached,total_steps,seconds,converged_episode,greedy_path_length\n";
+        for (const SeedResult& result : results) {
+            out << static_cast<long long>(result.seed) << ',' << result.summary.episodes << ','
+                << result.summary.goalsReached << ',' << result.summary.totalSteps << ','
+                << result.summary.seconds << ',' << result.summary.convergedEpisode << ','
+                << result.summary.greedyPathLength << '\n';
         }
+        return 0;
+    }
 
-        // Perform actions based on the chosen action
-        if (action == 2) { // Forward
-            moveAgent(agent, maze);
-            agent.lastAction = 2;
-            agent.moveHistory.push_back("Forward");
-        } else if (action == 3) { // Turn right then forward
-            turnAgent(agent, 3); // Right turn
-            moveAgent(agent, maze);
-            agent.lastAction = 2;
-            agent.moveHistory.push_back("Turn Right, Forward");
-        } else if (action == 1) { // Turn left then forward
-            turnAgent(agent, 1); // Left turn
-            moveAgent(agent, maze);
-            agent.lastAction = 1;
-            agent.moveHistory.push_back("Turn Left, Forward");
+    // Initialize the agent with its starting position and parameters
+    Agent agent = initializeAgent(maze, options.seed); // Ensure this function returns an Agent type
+    if (!options.loadFile.empty()) {
+        // Warm start from a checkpoint; its Q-values are mapped, not read
+        if (!loadAgentCheckpoint(options.loadFile, agent, maze)) {
+            return 1;
         }
+        out << "Loaded checkpoint " << options.loadFile << " trained for " << agent.episodesTrained << " episodes\n";
+    }
+    applyTrainingOptions(agent, options);
+
+    // Log every step of training for the replay tool
+    TrajectoryWriter trajectory;
+    if (!options.trajectoryFile.empty() && !trajectory.open(options.trajectoryFile, maze)) {
+        return 1;
+    }
+
+    TrainingSummary summary = trainAgent(agent, maze, options, &out, trajectory.isOpen() ? &trajectory : nullptr);
+    if (!trajectory.close()) {
+        std::cerr << "Error: Failed to write trajectory " << options.trajectoryFile << std::endl;
+    }
+
+    out << "Trained " << summary.episodes << " episodes, " << summary.totalSteps << " steps in " << summary.seconds << " s";
+    if (summary.seconds > 0.0) {
+        out << " (" << summary.totalSteps / summary.seconds << " steps/s)";
+    }
+    out << '\n';
+    if (summary.convergedEpisode > 0) {
+        out << "Greedy path converged at episode " << summary.convergedEpisode << '\n';
+    }
+    out << "Greedy path length: " << summary.greedyPathLength << '\n';
 
-        // Update the agent's state based on its new position
-        updateAgentState(agent, maze);
-        steps++;
-        // Print the maze after each move
-        printMaze(maze, agent);
-        std::cout << "-------------------------------------" << std::endl;
-
-        // Update Q-values based on the agent's actions and rewards
-        std::pair<int, int> oldState = {agent.previousPosition.x, agent.previousPosition.y};
-        std::pair<int, int> newState = {agent.position.x, agent.position.y};
-        int actionIndex = std::find(agent.actionList.begin(), agent.actionList.end(), action) - agent.actionList.begin();
-
-        // Calculate reward based on the current position in the maze
-        double reward = (maze[newState.first][newState.second] == GOAL) ? 100.0 : -1.0;
-
-        // Correct way to find the maximum Q-value for the new state
-        auto maxElementIter = std::max_element(agent.QTable[newState].begin(), agent.QTable[newState].end());
-        double maxQValue = (maxElementIter != agent.QTable[newState].end()) ? *maxElementIter : 0.0;
-
-        // Update the Q-table
-        agent.QTable[oldState][actionIndex] += agent.learningRate * (reward + agent.discountFactor * maxQValue - agent.QTable[oldState][actionIndex]);
-
-        // Check if goal is reached
-        if (maze[agent.position.x][agent.position.y] == GOAL) {
-            std::cout << "Goal reached in " << steps << " steps!" << std::endl;
-
-            // Print the list of moves
-            std::cout << "List of moves: ";
-            for (const auto& move : agent.moveHistory) {
-                std::cout << move << "; ";
-            }
-            std::cout << std::endl;
-            std::cout << "Goal reached in " << steps << " steps!" << std::endl;
-            std::cout << "Position changed " << agent.positionChangeCount << " times." << std::endl;
-
-            break;
+    if (!options.checkpointFile.empty()) {
+        maze.restoreItems();
+        if (saveAgentCheckpoint(options.checkpointFile, agent, maze)) {
+            out << "Checkpoint written to " << options.checkpointFile << '\n';
         }
-        if (++steps >= maxSteps) {
-            std::cerr << "Maximum steps reached. Exiting loop." << std::endl;
-            break;
     }
 
-    
+    // Evaluate the learned policy with many agents stepped in lockstep
+    if (options.evaluateAgents > 0) {
+        maze.restoreItems();
+        BatchEvaluation evaluation = evaluatePolicy(agent.qTable, maze, options.evaluateAgents,
+                                                    agent.policy, agent.explorationRate, options.maxSteps, options.seed);
+        out << "Evaluated " << evaluation.agents << " agents: " << evaluation.goalsReached << " reached the goal, "
+            << evaluation.meanSteps << " mean steps, " << evaluation.totalSteps << " steps in " << evaluation.seconds << " s\n";
+    }
+
+    // Show what the agent learned with a greedy, fully rendered rollout that leaves the Q-table as trained
+    if (options.renderFinal) {
+        maze.restoreItems();
+        resetAgent(agent, maze);
+        double explorationRate = agent.explorationRate;
+        agent.explorationRate = 0.0;
+        out << "Greedy rollout:\n";
+        EpisodeResult result;
+        if (options.live) {
+            out.flush();
+            TerminalRenderer screen(maze.rows, maze.cols);
+            result = runEpisode(agent, maze, options.maxSteps, nullptr, nullptr, &screen, false);
+            screen.release();
+        } else {
+            result = runEpisode(agent, maze, options.maxSteps, &out, nullptr, nullptr, false);
+        }
+        out << "Greedy rollout: " << (result.reachedGoal ? "goal reached" : "goal not reached")
+            << " in " << result.steps << " steps\n";
+        agent.explorationRate = explorationRate;
     }
 
     return 0;
 }
-
-
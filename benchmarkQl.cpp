@@ -0,0 +1,147 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Maze.h"
+#include "QLearningAgent.h"
+#include "Version_2/MazeBinary.h"
+#include "Version_2/Benchmark.h"
+#include "Version_2/Benchmark/BenchmarkMazes.h"
+
+// Measures QLearningAgent::move throughput and Maze load times, and writes the results as
+// Google Benchmark JSON so runs from different commits can be compared.
+// Build together with Maze.cpp, QLearningAgent.cpp, QPlanner.cpp, Version_2/MazeBinary.cpp,
+// Version_2/MazeGenerator.cpp, Version_2/BufferedWriter.cpp and Version_2/QCheckpoint.cpp,
+// with -O2 -DNDEBUG so tracing is compiled out.
+// Usage: benchmarkQl [--out results.json] [--min-time seconds] [--generated size ...]
+//                    [--policy epsilon|softmax|ucb] [--exploration value] [--planning-steps n]
+//                    [maze files ...]
+// Without maze files the checked-in test mazes are used. Generated mazes default to 256 and 2048.
+// --policy and --exploration set the agent's exploration policy and its parameter, and
+// --planning-steps turns on Dyna-Q planning; the move benchmarks are then named after them.
+
+// Q-learning steps from START; the agent starts over by itself every MAX_STEPS moves.
+static void benchmarkMove(BenchmarkRunner& runner, const std::string& name, const std::string& fileName,
+                          const ExplorationPolicy& policy, int planningSteps) {
+    Maze maze(fileName);
+    std::pair<int, int> start = maze.findNumberCoordinates(START);
+    QLearningAgent agent(maze, start.first, start.second, 1);
+    agent.setExplorationPolicy(policy);
+    agent.enablePlanning(maze, planningSteps);
+    runner.run("BM_QLearningAgentMove/" + name, [&](long long iterations) {
+        for (long long i = 0; i < iterations; ++i) {
+            agent.move(maze);
+        }
+        return iterations;
+    });
+}
+
+// Loading the maze from a file. Items are cells per second.
+static void benchmarkLoad(BenchmarkRunner& runner, const std::string& name, const std::string& fileName) {
+    runner.run(name, [&](long long iterations) {
+        long long cells = 0;
+        for (long long i = 0; i < iterations; ++i) {
+            Maze maze(fileName);
+            cells += static_cast<long long>(maze.getSize().first) * maze.getSize().second;
+        }
+        return cells;
+    });
+}
+
+int main(int argc, char* argv[]) {
+    std::string outFile = "benchmark_ql_results.json";
+    double minTime = 0.5;
+    std::vector<int> generatedSizes;
+    std::vector<std::string> mazeFiles;
+    ExplorationPolicy policy;
+    int planningSteps = 0;
+    std::string configuration; // Suffix of the move benchmark names for non-default settings
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outFile = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (arg == "--generated" && i + 1 < argc) {
+            generatedSizes.push_back(std::atoi(argv[++i]));
+        } else if (arg == "--policy" && i + 1 < argc) {
+            if (!parseExplorationStrategy(argv[++i], policy.strategy)) {
+                std::cerr << "Error: --policy must be epsilon, softmax or ucb." << std::endl;
+                return 1;
+            }
+            configuration += "/" + std::string(argv[i]);
+        } else if (arg == "--exploration" && i + 1 < argc) {
+            policy.start = std::atof(argv[++i]);
+            configuration += "/exploration_" + std::string(argv[i]);
+        } else if (arg == "--planning-steps" && i + 1 < argc) {
+            planningSteps = std::atoi(argv[++i]);
+            configuration += "/planning_" + std::to_string(planningSteps);
+        } else {
+            mazeFiles.push_back(arg);
+        }
+    }
+    if (mazeFiles.empty()) {
+        mazeFiles = {"maze_testrun_1_newlines.txt", "maze_testrun_2_newlines.txt", "Version_2/maze.txt"};
+    }
+    if (generatedSizes.empty()) {
+        generatedSizes = {256, 2048};
+    }
+
+    // Text and binary file of each maze; generated mazes are written for the run.
+    std::vector<std::string> names, textFiles, binaryFiles, temporaryFiles;
+    for (const std::string& fileName : mazeFiles) {
+        names.push_back(benchmarkMazeName(fileName));
+        textFiles.push_back(fileName);
+    }
+    for (int size : generatedSizes) {
+        if (size <= 0) {
+            continue;
+        }
+        std::string name = "generated_" + std::to_string(size) + "x" + std::to_string(size);
+        if (!writeMazeText(name + ".bench.txt", makeBenchmarkMaze(size, size, size))) {
+            std::cerr << "Error: Failed to write " << name << ".bench.txt" << std::endl;
+            continue;
+        }
+        names.push_back(name);
+        textFiles.push_back(name + ".bench.txt");
+        temporaryFiles.push_back(textFiles.back());
+    }
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        std::string binaryFile = names[i] + ".bench.mzb";
+        MazeGrid grid;
+        Maze maze(textFiles[i]);
+        // Copy the maze as the root loader sees it into a grid for the binary writer.
+        grid.resize(maze.getSize().first, maze.getSize().second);
+        for (int row = 0; row < grid.rows; ++row) {
+            for (int col = 0; col < grid.cols; ++col) {
+                grid[row][col] = maze.at(row, col);
+            }
+        }
+        binaryFiles.push_back(!grid.empty() && writeMazeBinary(binaryFile, grid) ? binaryFile : "");
+        if (!binaryFiles.back().empty()) {
+            temporaryFiles.push_back(binaryFile);
+        }
+    }
+
+    BenchmarkRunner runner(minTime);
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        benchmarkMove(runner, names[i] + configuration, textFiles[i], policy, planningSteps);
+        benchmarkLoad(runner, "BM_MazeLoadText/" + names[i], textFiles[i]);
+        if (!binaryFiles[i].empty()) {
+            benchmarkLoad(runner, "BM_MazeLoadBinary/" + names[i], binaryFiles[i]);
+        }
+    }
+
+    for (const std::string& fileName : temporaryFiles) {
+        std::remove(fileName.c_str());
+    }
+
+    if (!runner.writeJson(outFile, argv[0])) {
+        std::cerr << "Error: Failed to write " << outFile << std::endl;
+        return 1;
+    }
+    std::cout << "Results written to " << outFile << std::endl;
+    return 0;
+}
@@ -8,19 +8,14 @@
 #include <algorithm> // For std::max_element
 #include <unordered_map>
 
+#include "Version_2/Random.h"
+#include "Version_2/MoveHistory.h"
+#include "Version_2/TerminalRenderer.h"
 
 
-// Enumeration representing different elements that can be found in the maze.
-enum MazeElements {
-    EMPTY = 0, // Represents an empty cell
-    WALL = 1, // Represents a wall
-    START = 2, // Represents the start position
-    GOAL = 3, // Represents the goal position
-    GOGGLES = 4, // Represents goggles item
-    SPEED_POTION = 5, // Represents a speed potion
-    FOG = 6, // Represents fog
-    SLOWPOKE_POTION = 7 // Represents a slowpoke potion
-};
+
+// Cell codes and their effects, shared with the rest of the project
+#include "Version_2/MazeElements.h"
 
 // Enumeration representing the four cardinal directions.
 enum Direction { NORTH, EAST, SOUTH, WEST };
@@ -47,7 +42,7 @@ struct Agent {
     Direction direction; // Current direction of the agent
     int stepSize; // Step size of the agent
     int perceptField; // Perceptual field of the agent
-    std::vector<std::string> moveHistory; // History of moves taken by the agent
+    MoveHistory moveHistory; // History of moves taken by the agent, 2 bits per move
     std::vector<int> actionList; // List of possible actions the agent can take
     int lastAction; // The last action taken by the agent
     int positionChangeCount; // Counts changes in position
@@ -56,6 +51,7 @@ struct Agent {
     double discountFactor; // Discount factor for the Q-learning algorithm
     double explorationRate; // Exploration rate for the Q-learning algorithm
     std::unordered_map<std::pair<int, int>, std::vector<double>, pair_hash> QTable; // Q-table for storing state-action values
+    RandomGenerator rng; // Random number generator for exploration
 };
 
 // Template function to print a variable to the console.
@@ -88,37 +84,27 @@ std::vector<std::vector<int>> readMaze(const std::string& fileName) {
 
 
 
-// Function to print the maze with the agent's current position and direction.
-void printMaze(const std::vector<std::vector<int>>& maze, const Agent& agent) {
-    char agentSymbol;
-    // Determine the symbol to represent the agent's direction.
+// Function to get the symbol of the agent facing its direction.
+char agentSymbol(const Agent& agent) {
     switch (agent.direction) {
-        case NORTH: agentSymbol = '^'; break;
-        case EAST:  agentSymbol = '>'; break;
-        case SOUTH: agentSymbol = 'V'; break;
-        case WEST:  agentSymbol = '<'; break;
+        case NORTH: return '^';
+        case EAST:  return '>';
+        case SOUTH: return 'V';
+        case WEST:  return '<';
     }
+    return 'X'; // 'X' marks an invalid direction
+}
 
-    // Iterate through the maze and print each cell.
-    for (int i = 0; i < maze.size(); ++i) {
-        for (int j = 0; j < maze[i].size(); ++j) {
-            // Print the agent symbol if the current cell is the agent's position.
-            if (agent.position.x == i && agent.position.y == j) {
-                // Validate if the agent's position is within the bounds of the maze.
-                if (agent.position.x >= 0 && agent.position.x < maze.size() &&
-                    agent.position.y >= 0 && agent.position.y < maze[i].size()) {
-                    std::cout << agentSymbol << " "; // Display agent with its direction.
-                } else {
-                    // Handle out-of-bounds position.
-                    std::cout << "X "; // Print 'X' or other symbol for invalid position.
-                }
-            } else {
-                // Print the maze element for non-agent cells.
-                std::cout << maze[i][j] << " ";
-            }
+// Function to draw the maze with the agent's current position and direction into the next
+// frame of the screen. Only the cells that changed since the last frame reach the terminal.
+void drawMaze(const std::vector<std::vector<int>>& maze, const Agent& agent, TerminalRenderer& screen) {
+    screen.follow(agent.position.x, agent.position.y);
+    for (int i = screen.top(); i < static_cast<int>(maze.size()) && i < screen.top() + screen.height(); ++i) {
+        for (int j = screen.left(); j < static_cast<int>(maze[i].size()) && j < screen.left() + screen.width(); ++j) {
+            screen.set(i, j, static_cast<char>('0' + maze[i][j]));
         }
-        std::cout << std::endl;
     }
+    screen.set(agent.position.x, agent.position.y, agentSymbol(agent));
 }
 
 // Function to initialize the agent with initial settings and QTable.
@@ -206,24 +192,11 @@ void updateAgentState(Agent& agent, std::vector<std::vector<int>>& maze) {
         
         int& cell = maze[agent.position.x][agent.position.y]; // Reference to the cell at the agent's position.
 
-        // Process the cell based on its value and update the agent's state accordingly.
-        switch (cell) {
-            case GOGGLES: 
-                agent.perceptField = std::min(agent.perceptField + 1, 3); // Increase perceptual field.
-                cell = EMPTY; // Remove goggles from the maze.
-                break;
-            case SPEED_POTION: 
-                agent.stepSize = std::min(agent.stepSize + 1, 3); // Increase movement speed.
-                cell = EMPTY; // Remove speed potion.
-                break;
-            case FOG: 
-                agent.perceptField = std::max(agent.perceptField - 1, 1); // Decrease perceptual field.
-                cell = EMPTY; // Remove fog.
-                break;
-            case SLOWPOKE_POTION: 
-                agent.stepSize = std::max(agent.stepSize - 1, 1); // Decrease movement speed.
-                cell = EMPTY; // Remove slowpoke potion.
-                break;
+        // Apply the item effect from the cell table and remove the item if it is used up.
+        agent.stepSize = stepSizeAfter(agent.stepSize, cell);
+        agent.perceptField = perceptFieldAfter(agent.perceptField, cell);
+        if (isConsumable(cell)) {
+            cell = EMPTY;
         }
     }
     else {
@@ -248,9 +221,9 @@ int decideNextAction(Agent& agent, const std::vector<std::vector<int>>& maze) {
     double maxQValue = -std::numeric_limits<double>::infinity(); // Lowest possible double value.
 
     // Decide whether to explore (try new actions) or exploit (use best-known actions).
-    if ((double)rand() / RAND_MAX < agent.explorationRate) {
+    if (agent.rng.nextDouble() < agent.explorationRate) {
         // Exploration: Randomly choose an action from the available action list.
-        return agent.actionList[rand() % agent.actionList.size()];
+        return agent.actionList[agent.rng.nextBelow(agent.actionList.size())];
     } else {
         // Exploitation: Choose the action with the highest Q-value from the QTable.
         for (size_t i = 0; i < agent.actionList.size(); ++i) {
@@ -288,16 +261,19 @@ int main() {
 
     // Perform the first move of the agent
     moveAgent(agent, maze);
-    agent.moveHistory.push_back("Forward");
+    agent.moveHistory.push(2);
     steps++;
 
-    // Print the initial state of the maze with the agent's position
-    printMaze(maze, agent);
+    // Show the initial state of the maze with the agent's position. The maze is drawn in
+    // place, so each step rewrites only the cells that changed.
+    TerminalRenderer screen(maze.size(), maze.empty() ? 0 : maze[0].size());
     
     // Main game loop to iterate through the steps of the agent
     while (steps < maxSteps) {
-        // Output the current step and agent's position
-        std::cout << "Step " << steps << ": Position (" << agent.position.x << ", " << agent.position.y << ")" << std::endl;
+        // Show the maze with the current step and agent's position below it
+        drawMaze(maze, agent, screen);
+        screen.setStatus("Step " + std::to_string(steps) + ": Position (" + std::to_string(agent.position.x) + ", " + std::to_string(agent.position.y) + ")");
+        screen.present();
 
         // Decide the next action for the agent based on its current state and the maze
         int action = decideNextAction(agent, maze);
@@ -307,6 +283,7 @@ int main() {
         
         // Check if the maximum number of steps has been reached
         if (steps >= maxSteps) {
+            screen.release();
             std::cout << "Maximum steps reached. Exiting." << std::endl;
             break;
         }
@@ -318,17 +295,15 @@ int main() {
             // Check if the agent has reached the goal
             if (maze[agent.position.x][agent.position.y] == GOAL) {
                 // Output success message and the list of moves taken
+                screen.release();
                 std::cout << "Goal reached in " << steps << " steps!" << std::endl;
-                std::cout << "List of moves: ";
-                for (const auto& move : agent.moveHistory) {
-                    std::cout << move << "; ";
-                }
-                std::cout << std::endl;
+                agent.moveHistory.printRuns(std::cout);
                 std::cout << "Position changed " << agent.positionChangeCount << " times." << std::endl;
                 break; // Exit the loop since the goal is reached
             }
         } else {
             // Handle the case where the agent is out of the maze bounds
+            screen.release();
             std::cerr << "Error: Agent is out of bounds." << std::endl;
             break; // Consider breaking the loop or resetting the agent's position
         }
@@ -337,33 +312,32 @@ int main() {
         if (action == 2) { // Forward
             moveAgent(agent, maze);
             agent.lastAction = 2;
-            agent.moveHistory.push_back("Forward");
+            agent.moveHistory.push(2);
         } else if (action == 3) { // Turn right then forward
             turnAgent(agent, 3); // Right turn
             moveAgent(agent, maze);
             agent.lastAction = 2;
-            agent.moveHistory.push_back("Turn Right, Forward");
+            agent.moveHistory.push(3);
         } else if (action == 1) { // Turn left then forward
             turnAgent(agent, 1); // Left turn
             moveAgent(agent, maze);
             agent.lastAction = 1;
-            agent.moveHistory.push_back("Turn Left, Forward");
+            agent.moveHistory.push(1);
         }
 
-        // Update the agent's state based on its new position
+        // Update the agent's state based on its new position, remembering the cell entered
+        // since an item on it is taken
+        int enteredCell = maze[agent.position.x][agent.position.y];
         updateAgentState(agent, maze);
         steps++;
-        // Print the maze after each move
-        printMaze(maze, agent);
-        std::cout << "-------------------------------------" << std::endl;
 
         // Update Q-values based on the agent's actions and rewards
         std::pair<int, int> oldState = {agent.previousPosition.x, agent.previousPosition.y};
         std::pair<int, int> newState = {agent.position.x, agent.position.y};
         int actionIndex = std::find(agent.actionList.begin(), agent.actionList.end(), action) - agent.actionList.begin();
 
-        // Calculate reward based on the current position in the maze
-        double reward = (maze[newState.first][newState.second] == GOAL) ? 100.0 : -1.0;
+        // Reward of the cell entered, from the cell table
+        double reward = cellReward(enteredCell);
 
         // Correct way to find the maximum Q-value for the new state
         auto maxElementIter = std::max_element(agent.QTable[newState].begin(), agent.QTable[newState].end());
@@ -374,20 +348,20 @@ int main() {
 
         // Check if goal is reached
         if (maze[agent.position.x][agent.position.y] == GOAL) {
+            drawMaze(maze, agent, screen);
+            screen.present();
+            screen.release();
             std::cout << "Goal reached in " << steps << " steps!" << std::endl;
 
             // Print the list of moves
-            std::cout << "List of moves: ";
-            for (const auto& move : agent.moveHistory) {
-                std::cout << move << "; ";
-            }
-            std::cout << std::endl;
+            agent.moveHistory.printRuns(std::cout);
             std::cout << "Goal reached in " << steps << " steps!" << std::endl;
             std::cout << "Position changed " << agent.positionChangeCount << " times." << std::endl;
 
             break;
         }
         if (++steps >= maxSteps) {
+            screen.release();
             std::cerr << "Maximum steps reached. Exiting loop." << std::endl;
             break;
     }